@@ -0,0 +1,32 @@
+// Shared helpers of the benchmarks. Include after dawn_utils.h.
+
+#include <time.h>
+
+static double bench_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec*1e-9;
+}
+
+// Results are added here and printed at the end, so that the compiler
+// cannot drop the measured work.
+static uint64_t bench_sink = 0;
+
+// Repeats body until at least min_seconds have passed, then sets
+// seconds_per_rep to the mean time of one repetition. The clock is read
+// after batches of doubling size, so that it does not dominate short bodies.
+#define BENCH_REPEAT(min_seconds, seconds_per_rep, body)                          \
+    do {                                                                          \
+        size_t bench_reps = 0;                                                    \
+        size_t bench_batch = 1;                                                   \
+        double bench_start = bench_now();                                         \
+        double bench_elapsed;                                                     \
+        do {                                                                      \
+            for (size_t bench_i = 0; bench_i < bench_batch; ++bench_i) {          \
+                body;                                                             \
+            }                                                                     \
+            bench_reps += bench_batch;                                            \
+            bench_batch *= 2;                                                     \
+        } while ((bench_elapsed = bench_now() - bench_start) < (min_seconds));    \
+        (seconds_per_rep) = bench_elapsed/(double)bench_reps;                     \
+    } while (0)
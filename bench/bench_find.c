@@ -0,0 +1,35 @@
+// dawn_find against glibc memmem on text that does not contain the needle,
+// so both scan the whole haystack, in GB/s.
+// Usage: ./bench_find [haystack_bytes]
+
+#define _GNU_SOURCE
+#define DAWN_IMPLEMENTATION
+#include "../dawn_utils.h"
+#include "bench.h"
+
+int main(int argc, char **argv) {
+    size_t length = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : (size_t)16 << 20;
+    char *haystack = (char *)malloc(length);
+    assert(haystack && "Not enough RAM for malloc");
+    DawnRng rng;
+    dawn_rng_seed(&rng, DAWN_RNG_XOSHIRO256PP, 33);
+    // English-like letter frequencies make first and last byte matches common.
+    static const char letters[] = "eeeeeeeeeeeetttttttttaaaaaaaaooooooooiiiiiiinnnnnnnsssssshhhhhhrrrrrdddd  lllcccuuummwwffggyyppbbvkjxqz";
+    for (size_t i = 0; i < length; ++i) haystack[i] = letters[dawn_rng_bounded(&rng, sizeof letters - 1)];
+
+    // Letters that do not occur, at both ends, with common ones in between.
+    static const char needle[] = "Zthe rest of the needle is made of frequent letters to keep it hard Q";
+    printf("%8s %12s %12s\n", "needle", "dawn_find", "memmem");
+    for (size_t needle_length = 1; needle_length <= 64; needle_length *= 2) {
+        char buf[64];
+        memcpy(buf, needle, needle_length);
+        buf[needle_length - 1] = 'Q';
+        double find_s, memmem_s;
+        BENCH_REPEAT(0.3, find_s, bench_sink += dawn_find(haystack, length, buf, needle_length));
+        BENCH_REPEAT(0.3, memmem_s, bench_sink += (uintptr_t)memmem(haystack, length, buf, needle_length));
+        printf("%8zu %7.2f GB/s %7.2f GB/s\n", needle_length, length/find_s*1e-9, length/memmem_s*1e-9);
+    }
+    free(haystack);
+    printf("(sink %llu)\n", (unsigned long long)bench_sink);
+    return 0;
+}
@@ -0,0 +1,47 @@
+// dawn_hash64 and DawnHasher against byte-at-a-time FNV-1a, in GB/s.
+// Usage: ./bench_hash [max_bytes]
+
+#define _POSIX_C_SOURCE 199309L
+#define DAWN_IMPLEMENTATION
+#include "../dawn_utils.h"
+#include "bench.h"
+
+static uint64_t fnv1a(const void *buf, size_t length) {
+    const unsigned char *p = (const unsigned char *)buf;
+    uint64_t h = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < length; ++i) {
+        h ^= p[i];
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+int main(int argc, char **argv) {
+    size_t max_bytes = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : (size_t)64 << 20;
+    unsigned char *data = (unsigned char *)malloc(max_bytes);
+    assert(data && "Not enough RAM for malloc");
+    DawnRng rng;
+    dawn_rng_seed(&rng, DAWN_RNG_XOSHIRO256PP, 28);
+    for (size_t i = 0; i < max_bytes; ++i) data[i] = (unsigned char)dawn_rng_u64(&rng);
+
+    printf("%10s %12s %12s %12s\n", "bytes", "hash64", "hasher", "fnv1a");
+    for (size_t length = 16; length <= max_bytes; length *= 4) {
+        double hash_s, hasher_s, fnv_s;
+        BENCH_REPEAT(0.2, hash_s, bench_sink += dawn_hash64(data, length, bench_sink));
+        BENCH_REPEAT(0.2, hasher_s, {
+            DawnHasher hasher;
+            dawn_hasher_init(&hasher, bench_sink);
+            // Streamed in 4 KiB pieces, as when hashing a file being read.
+            for (size_t i = 0; i < length; i += 4096) {
+                dawn_hasher_update(&hasher, data + i, length - i < 4096 ? length - i : 4096);
+            }
+            bench_sink += dawn_hasher_digest(&hasher);
+        });
+        BENCH_REPEAT(0.2, fnv_s, bench_sink += fnv1a(data, length));
+        printf("%10zu %9.2f GB/s %7.2f GB/s %7.2f GB/s\n", length,
+               length/hash_s*1e-9, length/hasher_s*1e-9, length/fnv_s*1e-9);
+    }
+    free(data);
+    printf("(sink %llu)\n", (unsigned long long)bench_sink);
+    return 0;
+}
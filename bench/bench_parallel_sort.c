@@ -0,0 +1,40 @@
+// name_parallel_sort with 1 to N threads against the serial name_sort, on
+// random u64 keys. N defaults to the number of online CPUs.
+// Usage: ./bench_parallel_sort [count] [max_threads]
+
+#define _POSIX_C_SOURCE 199309L
+#define DAWN_WITH_THREADS
+#define DAWN_IMPLEMENTATION
+#include "../dawn_utils.h"
+#include "bench.h"
+
+DAWN_DEFINE_SORT(sort_u64, uint64_t, *a < *b)
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 20000000;
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    size_t max_threads = argc > 2 ? (size_t)strtoull(argv[2], NULL, 10) : online > 0 ? (size_t)online : 1;
+    uint64_t *input = (uint64_t *)malloc(count*sizeof *input);
+    uint64_t *work = (uint64_t *)malloc(count*sizeof *work);
+    assert(input && work && "Not enough RAM for malloc");
+    DawnRng rng;
+    dawn_rng_seed(&rng, DAWN_RNG_XOSHIRO256PP, 49);
+    dawn_rng_fill_u64(&rng, input, count);
+
+    double serial_s;
+    BENCH_REPEAT(1.0, serial_s, { memcpy(work, input, count*sizeof *work); sort_u64_sort(work, count); });
+    printf("%zu u64, serial pdqsort %.0f ms\n%8s %10s %10s\n", count, serial_s*1e3, "threads", "ms", "speedup");
+    for (size_t threads = 1; threads <= max_threads; ++threads) {
+        double parallel_s;
+        BENCH_REPEAT(1.0, parallel_s, {
+            memcpy(work, input, count*sizeof *work);
+            sort_u64_parallel_sort(work, count, threads);
+        });
+        printf("%8zu %10.0f %9.2fx\n", threads, parallel_s*1e3, serial_s/parallel_s);
+    }
+    bench_sink += work[count/2];
+    free(input);
+    free(work);
+    printf("(sink %llu)\n", (unsigned long long)bench_sink);
+    return 0;
+}
@@ -0,0 +1,118 @@
+// dawn_radix_sort against qsort, the pdqsort of DAWN_DEFINE_SORT and
+// std::sort, in millions of items per second on random keys.
+// Usage: ./bench_radix [count]
+
+#define _POSIX_C_SOURCE 199309L
+#define DAWN_IMPLEMENTATION
+#include "../dawn_utils.h"
+#include "bench.h"
+
+// From bench_std_sort.cpp.
+void bench_std_sort_u32(void *items, size_t count);
+void bench_std_sort_u64(void *items, size_t count);
+void bench_std_sort_f64(void *items, size_t count);
+void bench_std_sort_keyed(void *items, size_t count);
+
+typedef struct {
+    uint32_t key;
+    uint32_t payload;
+} Keyed;
+
+DAWN_DEFINE_SORT(sort_u32, uint32_t, *a < *b)
+DAWN_DEFINE_SORT(sort_u64, uint64_t, *a < *b)
+DAWN_DEFINE_SORT(sort_f64, double, *a < *b)
+DAWN_DEFINE_SORT(sort_keyed, Keyed, a->key < b->key)
+
+static int compare_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_f64(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static int compare_keyed(const void *a, const void *b) {
+    return compare_u32(&((const Keyed *)a)->key, &((const Keyed *)b)->key);
+}
+
+// Preallocated, as a caller sorting repeatedly would do.
+static void *radix_scratch;
+
+static void radix_u32(void *items, size_t count) {
+    dawn_radix_sort(items, count, sizeof(uint32_t), 0, DAWN_RADIX_U32, radix_scratch);
+}
+
+static void radix_u64(void *items, size_t count) {
+    dawn_radix_sort(items, count, sizeof(uint64_t), 0, DAWN_RADIX_U64, radix_scratch);
+}
+
+static void radix_f64(void *items, size_t count) {
+    dawn_radix_sort(items, count, sizeof(double), 0, DAWN_RADIX_F64, radix_scratch);
+}
+
+static void radix_keyed(void *items, size_t count) {
+    dawn_radix_sort(items, count, sizeof(Keyed), offsetof(Keyed, key), DAWN_RADIX_U32, radix_scratch);
+}
+
+typedef void (*SortFunction)(void *items, size_t count);
+
+// Every sort starts from a copy of the same input. The copy is timed too,
+// it is small next to any of the sorts.
+static void bench_sorts(const char *label, const void *input, size_t count, size_t item_size,
+                        SortFunction radix, SortFunction pdq, SortFunction std_sort,
+                        int (*compare)(const void *, const void *)) {
+    unsigned char *work = (unsigned char *)malloc(count*item_size);
+    assert(work && "Not enough RAM for malloc");
+    double radix_s, qsort_s, pdq_s, std_s;
+    BENCH_REPEAT(0.5, radix_s, { memcpy(work, input, count*item_size); radix(work, count); });
+    BENCH_REPEAT(0.5, qsort_s, { memcpy(work, input, count*item_size); qsort(work, count, item_size, compare); });
+    BENCH_REPEAT(0.5, pdq_s, { memcpy(work, input, count*item_size); pdq(work, count); });
+    BENCH_REPEAT(0.5, std_s, { memcpy(work, input, count*item_size); std_sort(work, count); });
+    bench_sink += work[0];
+    printf("%-6s %8.1f M/s %8.1f M/s %8.1f M/s %8.1f M/s\n", label,
+           count/radix_s*1e-6, count/qsort_s*1e-6, count/pdq_s*1e-6, count/std_s*1e-6);
+    free(work);
+}
+
+int main(int argc, char **argv) {
+    size_t count = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 1000000;
+    uint64_t *bits = (uint64_t *)malloc(count*sizeof *bits);
+    radix_scratch = malloc(count*sizeof(uint64_t));
+    assert(bits && radix_scratch && "Not enough RAM for malloc");
+    DawnRng rng;
+    dawn_rng_seed(&rng, DAWN_RNG_XOSHIRO256PP, 47);
+    dawn_rng_fill_u64(&rng, bits, count);
+
+    uint32_t *u32 = (uint32_t *)malloc(count*sizeof *u32);
+    double *f64 = (double *)malloc(count*sizeof *f64);
+    Keyed *keyed = (Keyed *)malloc(count*sizeof *keyed);
+    assert(u32 && f64 && keyed && "Not enough RAM for malloc");
+    for (size_t i = 0; i < count; ++i) {
+        u32[i] = (uint32_t)bits[i];
+        f64[i] = ((double)(bits[i] >> 11) - (double)(1ull << 52))*1e-3;
+        keyed[i].key = (uint32_t)(bits[i] >> 32);
+        keyed[i].payload = (uint32_t)i;
+    }
+
+    printf("%zu items\n%-6s %12s %12s %12s %12s\n", count, "key", "radix", "qsort", "pdqsort", "std::sort");
+    bench_sorts("u32", u32, count, sizeof *u32, radix_u32, sort_u32_sort_items, bench_std_sort_u32, compare_u32);
+    bench_sorts("u64", bits, count, sizeof *bits, radix_u64, sort_u64_sort_items, bench_std_sort_u64, compare_u64);
+    bench_sorts("f64", f64, count, sizeof *f64, radix_f64, sort_f64_sort_items, bench_std_sort_f64, compare_f64);
+    bench_sorts("keyed", keyed, count, sizeof *keyed, radix_keyed, sort_keyed_sort_items, bench_std_sort_keyed,
+                compare_keyed);
+
+    free(bits);
+    free(u32);
+    free(f64);
+    free(keyed);
+    free(radix_scratch);
+    printf("(sink %llu)\n", (unsigned long long)bench_sink);
+    return 0;
+}
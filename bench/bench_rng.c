@@ -0,0 +1,56 @@
+// Bulk dawn_rng_fill_* against a loop of the single-value functions, in
+// millions of values per second, for a buffer that fits in L1 and one
+// that does not.
+// Usage: ./bench_rng [large_count]
+
+#define _POSIX_C_SOURCE 199309L
+#define DAWN_IMPLEMENTATION
+#include "../dawn_utils.h"
+#include "bench.h"
+
+static const char *kind_names[] = {"xoshiro256++", "pcg64"};
+
+int main(int argc, char **argv) {
+    size_t large = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : (size_t)1 << 22;
+    size_t counts[] = {2048, large};
+    uint64_t *u = (uint64_t *)malloc(large*sizeof *u);
+    float *f = (float *)malloc(large*sizeof *f);
+    double *d = (double *)malloc(large*sizeof *d);
+    assert(u && f && d && "Not enough RAM for malloc");
+
+    printf("%-13s %9s %-9s %14s %14s\n", "generator", "count", "values", "fill", "loop");
+    for (int kind = DAWN_RNG_XOSHIRO256PP; kind <= DAWN_RNG_PCG64; ++kind) {
+        DawnRng rng;
+        dawn_rng_seed(&rng, (DawnRngKind)kind, 42);
+        for (size_t c = 0; c < 2; ++c) {
+            size_t n = counts[c];
+            double fill_s, loop_s;
+
+            BENCH_REPEAT(0.2, fill_s, { dawn_rng_fill_u64(&rng, u, n); bench_sink += u[n - 1]; });
+            BENCH_REPEAT(0.2, loop_s, {
+                for (size_t i = 0; i < n; ++i) u[i] = dawn_rng_u64(&rng);
+                bench_sink += u[n - 1];
+            });
+            printf("%-13s %9zu %-9s %8.0f M/s %8.0f M/s\n", kind_names[kind], n, "u64", n/fill_s*1e-6, n/loop_s*1e-6);
+
+            BENCH_REPEAT(0.2, fill_s, { dawn_rng_fill_float(&rng, f, n); bench_sink += (uint64_t)(f[n - 1]*1e6f); });
+            BENCH_REPEAT(0.2, loop_s, {
+                for (size_t i = 0; i < n; ++i) f[i] = dawn_rng_float(&rng);
+                bench_sink += (uint64_t)(f[n - 1]*1e6f);
+            });
+            printf("%-13s %9zu %-9s %8.0f M/s %8.0f M/s\n", kind_names[kind], n, "float", n/fill_s*1e-6, n/loop_s*1e-6);
+
+            BENCH_REPEAT(0.2, fill_s, { dawn_rng_fill_normal(&rng, d, n); bench_sink += (uint64_t)(d[n - 1] > 0); });
+            BENCH_REPEAT(0.2, loop_s, {
+                for (size_t i = 0; i < n; ++i) d[i] = dawn_rng_normal(&rng);
+                bench_sink += (uint64_t)(d[n - 1] > 0);
+            });
+            printf("%-13s %9zu %-9s %8.0f M/s %8.0f M/s\n", kind_names[kind], n, "normal", n/fill_s*1e-6, n/loop_s*1e-6);
+        }
+    }
+    free(u);
+    free(f);
+    free(d);
+    printf("(sink %llu)\n", (unsigned long long)bench_sink);
+    return 0;
+}
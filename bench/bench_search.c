@@ -0,0 +1,66 @@
+// Lookups in sorted u32 arrays from L1 to DRAM sizes: a plain binary
+// search, dawn_lower_bound_u32, DawnEytzinger32 and DawnBTree32, in ns per
+// random lookup.
+// Usage: ./bench_search [max_count]
+
+#define _POSIX_C_SOURCE 199309L
+#define DAWN_IMPLEMENTATION
+#include "../dawn_utils.h"
+#include "bench.h"
+
+DAWN_DEFINE_SORT(sort_u32, uint32_t, *a < *b)
+
+#define QUERIES 4096
+
+// The textbook version with a branch on every comparison.
+static size_t branchy_lower_bound(const uint32_t *items, size_t count, uint32_t key) {
+    size_t lo = 0, hi = count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo)/2;
+        if (items[mid] < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+int main(int argc, char **argv) {
+    size_t max_count = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : (size_t)1 << 24;
+    uint32_t *items = (uint32_t *)malloc(max_count*sizeof *items);
+    assert(items && "Not enough RAM for malloc");
+    DawnRng rng;
+    dawn_rng_seed(&rng, DAWN_RNG_XOSHIRO256PP, 50);
+    uint32_t queries[QUERIES];
+    for (size_t i = 0; i < QUERIES; ++i) queries[i] = (uint32_t)dawn_rng_u64(&rng);
+
+    printf("%10s %10s %10s %10s %10s %10s\n", "keys", "KiB", "branchy", "branchless", "eytzinger", "btree");
+    for (size_t count = 1024; count <= max_count; count *= 4) {
+        for (size_t i = 0; i < count; ++i) items[i] = (uint32_t)dawn_rng_u64(&rng);
+        sort_u32_sort(items, count);
+        DawnEytzinger32 eytzinger;
+        DawnBTree32 btree;
+        dawn_eytzinger32_build(&eytzinger, items, count);
+        dawn_btree32_build(&btree, items, count);
+
+        // Each pass looks up every query once, so times are per QUERIES lookups.
+        double branchy_s, branchless_s, eytzinger_s, btree_s;
+        BENCH_REPEAT(0.2, branchy_s, {
+            for (size_t q = 0; q < QUERIES; ++q) bench_sink += branchy_lower_bound(items, count, queries[q]);
+        });
+        BENCH_REPEAT(0.2, branchless_s, {
+            for (size_t q = 0; q < QUERIES; ++q) bench_sink += dawn_lower_bound_u32(items, count, queries[q]);
+        });
+        BENCH_REPEAT(0.2, eytzinger_s, {
+            for (size_t q = 0; q < QUERIES; ++q) bench_sink += dawn_eytzinger32_lower_bound(&eytzinger, queries[q]);
+        });
+        BENCH_REPEAT(0.2, btree_s, {
+            for (size_t q = 0; q < QUERIES; ++q) bench_sink += dawn_btree32_lower_bound(&btree, queries[q]);
+        });
+        printf("%10zu %10zu %7.1f ns %7.1f ns %7.1f ns %7.1f ns\n", count, count*sizeof *items/1024,
+               branchy_s/QUERIES*1e9, branchless_s/QUERIES*1e9, eytzinger_s/QUERIES*1e9, btree_s/QUERIES*1e9);
+        DAWN_EYTZINGER_FREE(eytzinger);
+        DAWN_BTREE_FREE(btree);
+    }
+    free(items);
+    printf("(sink %llu)\n", (unsigned long long)bench_sink);
+    return 0;
+}
@@ -0,0 +1,35 @@
+// std::sort for bench_radix.c, which is C and cannot instantiate it itself.
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+extern "C" {
+
+void bench_std_sort_u32(void *items, size_t count) {
+    uint32_t *p = static_cast<uint32_t *>(items);
+    std::sort(p, p + count);
+}
+
+void bench_std_sort_u64(void *items, size_t count) {
+    uint64_t *p = static_cast<uint64_t *>(items);
+    std::sort(p, p + count);
+}
+
+void bench_std_sort_f64(void *items, size_t count) {
+    double *p = static_cast<double *>(items);
+    std::sort(p, p + count);
+}
+
+// The Keyed struct of bench_radix.c: a uint32_t key and a uint32_t payload.
+struct Keyed {
+    uint32_t key;
+    uint32_t payload;
+};
+
+void bench_std_sort_keyed(void *items, size_t count) {
+    Keyed *p = static_cast<Keyed *>(items);
+    std::sort(p, p + count, [](const Keyed &a, const Keyed &b) { return a.key < b.key; });
+}
+
+}
@@ -22,11 +22,58 @@
 #define DAWN_H_
 
 #include <assert.h>
+#include <float.h>
+#include <math.h>
+#include <stdarg.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(__cplusplus) && __cplusplus >= 201103L
+#include <type_traits>
+#include <utility>
+#endif
+#if defined(__cplusplus) && __cplusplus >= 201703L
+#include <string_view>
+#endif
+
+// Define DAWN_NO_SIMD to force the scalar code paths.
+#if !defined(DAWN_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define DAWN_HAS_SSE2
+#include <emmintrin.h>
+#endif
+#if !defined(DAWN_NO_SIMD) && defined(__SSSE3__)
+#define DAWN_HAS_SSSE3
+#include <tmmintrin.h>
+#endif
+#if !defined(DAWN_NO_SIMD) && defined(__AVX2__)
+#define DAWN_HAS_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DAWN_PRINTF_FORMAT(fmt_index, args_index) __attribute__((format(printf, fmt_index, args_index)))
+#else
+#define DAWN_PRINTF_FORMAT(fmt_index, args_index)
+#endif
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__ || defined(_WIN32)
+#define DAWN_LITTLE_ENDIAN
+#endif
+
+#if defined(__cplusplus)
+#define DAWN_THREAD_LOCAL thread_local
+#elif defined(_MSC_VER)
+#define DAWN_THREAD_LOCAL __declspec(thread)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define DAWN_THREAD_LOCAL _Thread_local
+#else
+#define DAWN_THREAD_LOCAL __thread
+#endif
+
 #define DAWN_DEFER_RETURN(ret_val) \
     do {                           \
         result = (ret_val);        \
@@ -72,6 +119,21 @@
         (da)->length += elems_count;                                                       \
     } while (0)
 
+#define DAWN_DA_RESERVE(da, extra)                                                         \
+    do {                                                                                   \
+        if ((da)->length + (extra) >= (da)->capacity) {                                    \
+            if ((da)->capacity == 0) {                                                     \
+                (da)->capacity = DAWN_DA_DEFAULT_CAPACITY;                                 \
+            }                                                                              \
+            while ((da)->length + (extra) >= (da)->capacity) {                             \
+                (da)->capacity *= 2;                                                       \
+            }                                                                              \
+            void *dawn_temp = realloc((da)->items, (da)->capacity * sizeof *(da)->items);  \
+            assert(dawn_temp && "Not enough RAM for realloc");                             \
+            (da)->items = dawn_temp;                                                       \
+        }                                                                                  \
+    } while (0)
+
 #define DAWN_DA_PREPEND(da, elem)                                                         \
     do {                                                                                  \
         if ((da)->length == (da)->capacity) {                                             \
@@ -111,132 +173,6087 @@ typedef struct {
 
 #define DAWN_SB_APPEND_BUF(sb, buf, bufsize) DAWN_DA_APPEND_MANY(sb, buf, bufsize)
 
-/******************
- *Static functions*
- ******************/
+#define DAWN_SB_APPEND_SV(sb, sv)                              \
+    do {                                                       \
+        DawnStringView dawn_sv = (sv);                         \
+        DAWN_DA_APPEND_MANY(sb, dawn_sv.data, dawn_sv.length); \
+    } while (0)
 
-static inline int dawn_mod(int x, int n) {
-    return ((x%n) + n) % n;
+/**
+ * Append printf-style formatted text to the StringBuilder.
+ *
+ * The text is formatted straight into the spare capacity of sb. Only if it
+ * does not fit is sb grown and the formatting done again. A NUL terminator
+ * is left after the content but is not counted in its length.
+ *
+ * @return The number of bytes appended, or a negative value on a formatting error.
+ */
+int dawn_sb_appendf(DawnStringBuilder *sb, const char *fmt, ...) DAWN_PRINTF_FORMAT(2, 3);
+int dawn_sb_vappendf(DawnStringBuilder *sb, const char *fmt, va_list args);
+
+/**
+ * Append the decimal representation of an integer.
+ * Faster than dawn_sb_appendf and independent of the locale.
+ */
+void dawn_sb_append_u32(DawnStringBuilder *sb, uint32_t value);
+void dawn_sb_append_u64(DawnStringBuilder *sb, uint64_t value);
+void dawn_sb_append_i64(DawnStringBuilder *sb, int64_t value);
+
+/**
+ * Append an integer as lowercase hexadecimal digits, without a prefix.
+ *
+ * @param min_digits Pad with leading zeros to at least this many digits.
+ */
+void dawn_sb_append_hex(DawnStringBuilder *sb, uint64_t value, size_t min_digits);
+
+/**
+ * Append the shortest decimal representation that parses back to exactly
+ * the same value. Magnitudes from 1e-6 up to 1e21 are written in fixed
+ * notation ("0.001", "1500"), others in scientific notation ("1e+21").
+ * Special values are written as "nan", "inf" and "-inf".
+ */
+void dawn_sb_append_f64(DawnStringBuilder *sb, double value);
+void dawn_sb_append_f32(DawnStringBuilder *sb, float value);
+
+/*************
+ *String view*
+ *************/
+
+/**
+ * A non-owning view into a string. Slicing and chopping never allocate; the
+ * viewed memory must outlive the view.
+ */
+typedef struct {
+    const char *data;
+    size_t length;
+} DawnStringView;
+
+// printf("Name: " DAWN_SV_FMT "\n", DAWN_SV_ARG(sv));
+#define DAWN_SV_FMT "%.*s"
+#define DAWN_SV_ARG(sv) (int)(sv).length, (sv).data
+
+static inline DawnStringView dawn_sv_from_parts(const char *data, size_t length) {
+    DawnStringView sv = {data, length};
+    return sv;
 }
 
-static inline float dawn_rand_float() {
-    return (float)rand() / RAND_MAX;
+static inline DawnStringView dawn_sv_from_cstr(const char *cstr) {
+    return dawn_sv_from_parts(cstr, strlen(cstr));
 }
 
-/***********
- *Functions*
- ***********/
+static inline DawnStringView dawn_sv_from_sb(const DawnStringBuilder *sb) {
+    return dawn_sv_from_parts(sb->items, sb->length);
+}
+
+static inline bool dawn_sv_eq(DawnStringView a, DawnStringView b) {
+    return a.length == b.length && (a.length == 0 || memcmp(a.data, b.data, a.length) == 0);
+}
+
+static inline bool dawn_sv_starts_with(DawnStringView sv, DawnStringView prefix) {
+    return sv.length >= prefix.length && dawn_sv_eq(dawn_sv_from_parts(sv.data, prefix.length), prefix);
+}
+
+static inline bool dawn_sv_ends_with(DawnStringView sv, DawnStringView suffix) {
+    return sv.length >= suffix.length
+        && dawn_sv_eq(dawn_sv_from_parts(sv.data + sv.length - suffix.length, suffix.length), suffix);
+}
 
 /**
- * Shift out a command line arg.
+ * The part of sv starting at start, at most length bytes long.
+ * Out of range arguments are clamped.
  */
-char *dawn_shift_args(int *argc, char ***argv);
+static inline DawnStringView dawn_sv_slice(DawnStringView sv, size_t start, size_t length) {
+    if (start > sv.length) start = sv.length;
+    if (length > sv.length - start) length = sv.length - start;
+    return dawn_sv_from_parts(sv.data + start, length);
+}
+
+// Whitespace as in the "C" locale, independent of the current one.
+static inline bool dawn_is_space(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+static inline DawnStringView dawn_sv_trim_left(DawnStringView sv) {
+    size_t i = 0;
+    while (i < sv.length && dawn_is_space(sv.data[i])) i++;
+    return dawn_sv_from_parts(sv.data + i, sv.length - i);
+}
+
+static inline DawnStringView dawn_sv_trim_right(DawnStringView sv) {
+    size_t length = sv.length;
+    while (length > 0 && dawn_is_space(sv.data[length - 1])) length--;
+    return dawn_sv_from_parts(sv.data, length);
+}
+
+static inline DawnStringView dawn_sv_trim(DawnStringView sv) {
+    return dawn_sv_trim_right(dawn_sv_trim_left(sv));
+}
 
 /**
- * Read the contents of the given file.
+ * Find the first occurrence of c.
  *
- * @param filepath The path to the file to be read.
- * @param content The contents of the file will be appended to this StringBuilder.
- * @return Whether the process was successful.
- *      When a failure occurs, an error message is printed to stderr.
+ * @return Whether c was found. Its position is stored in index if it is not NULL.
  */
-bool dawn_read_entire_file(const char *filepath, DawnStringBuilder *content);
+static inline bool dawn_sv_index_of(DawnStringView sv, char c, size_t *index) {
+    const char *found = sv.length ? (const char *)memchr(sv.data, c, sv.length) : NULL;
+    if (!found) return false;
+    if (index) *index = found - sv.data;
+    return true;
+}
 
 /**
- * Write the content to the given file.
+ * Cut off and return the first n bytes of sv (or all of it, if it is shorter).
+ */
+static inline DawnStringView dawn_sv_chop_left(DawnStringView *sv, size_t n) {
+    if (n > sv->length) n = sv->length;
+    DawnStringView result = dawn_sv_from_parts(sv->data, n);
+    sv->data += n;
+    sv->length -= n;
+    return result;
+}
+
+/**
+ * Cut off and return everything before the first delim. The delimiter is
+ * dropped. If there is no delim, the whole of sv is returned and sv becomes empty.
  *
- * @param filepath The path to the file to be written to.
- * @param content The content that is to be written to the file.
- * @return Whether the process was successful.
- *      When a failure occurs, an error message is printed to stderr.
+ *     DawnStringView line = dawn_sv_chop_by_delim(&content, '\n');
  */
-bool dawn_write_entire_file(const char *filepath, const DawnStringBuilder *content);
+static inline DawnStringView dawn_sv_chop_by_delim(DawnStringView *sv, char delim) {
+    size_t i;
+    if (!dawn_sv_index_of(*sv, delim, &i)) return dawn_sv_chop_left(sv, sv->length);
+    DawnStringView result = dawn_sv_chop_left(sv, i);
+    dawn_sv_chop_left(sv, 1);
+    return result;
+}
 
-#endif // DAWN_H_
+#if defined(__cplusplus) && __cplusplus >= 201703L
+static inline std::string_view dawn_sv_to_std(DawnStringView sv) {
+    return std::string_view(sv.data, sv.length);
+}
 
-#ifdef DAWN_IMPLEMENTATION
+static inline DawnStringView dawn_sv_from_std(std::string_view sv) {
+    return dawn_sv_from_parts(sv.data(), sv.size());
+}
+#endif
 
-char *dawn_shift_args(int *argc, char ***argv) {
-    assert(*argc > 0);
-    char *arg = **argv;
-    (*argv)++;
-    (*argc)--;
-    return arg;
+/********
+ *Search*
+ ********/
+
+#define DAWN_NOT_FOUND SIZE_MAX
+
+/**
+ * Find the first occurrence of needle in haystack. Neither needs to be
+ * NUL-terminated. Candidates are filtered 32 (AVX2) or 16 (SSE2) positions
+ * at a time by comparing the first and last byte of the needle.
+ *
+ * @return The index of the match, or DAWN_NOT_FOUND. An empty needle matches at 0.
+ */
+size_t dawn_find(const char *haystack, size_t haystack_length, const char *needle, size_t needle_length);
+
+/**
+ * Find the first position in haystack at which any of the needles occurs.
+ * When several needles match there, the earliest in the list wins.
+ *
+ * @param which If not NULL, receives the index of the matching needle.
+ * @return The index of the match, or DAWN_NOT_FOUND.
+ */
+size_t dawn_find_any(const char *haystack, size_t haystack_length,
+                     const DawnStringView *needles, size_t needle_count, size_t *which);
+
+static inline size_t dawn_sv_find(DawnStringView haystack, DawnStringView needle) {
+    return dawn_find(haystack.data, haystack.length, needle.data, needle.length);
 }
 
-bool dawn_read_entire_file(const char *filepath, DawnStringBuilder *content) {
-    if (!filepath || !content) return 0;
+static inline size_t dawn_sb_find(const DawnStringBuilder *haystack, DawnStringView needle) {
+    return dawn_find(haystack->items, haystack->length, needle.data, needle.length);
+}
 
-    bool result;
+/**
+ * Replace every non-overlapping occurrence of from in sb with to, in a
+ * single left-to-right pass and in linear time. When to is longer than from,
+ * the final size is computed first so sb grows at most once. from and to must
+ * not point into sb.
+ *
+ * @return The number of replacements made.
+ */
+size_t dawn_sb_replace_all(DawnStringBuilder *sb, DawnStringView from, DawnStringView to);
 
-    FILE *f = NULL;
-    char *buf = NULL;
+/**
+ * Append src to out with every occurrence of from replaced by to.
+ *
+ * @return The number of replacements made.
+ */
+size_t dawn_sb_append_replaced(DawnStringBuilder *out, DawnStringView src, DawnStringView from, DawnStringView to);
 
-    f = fopen(filepath, "r");
-    if (!f) {
-        fprintf(stderr, "Failed to open file: %s\n", filepath);
-        DAWN_DEFER_RETURN(false);
-    }
+/*******
+ *UTF-8*
+ *******/
 
-    if (fseek(f, 0, SEEK_END)) {
-        perror("Failed to get to the end of file");
-        DAWN_DEFER_RETURN(false);
-    }
+/**
+ * Check that buf is well-formed UTF-8: no overlong encodings, surrogates,
+ * code points above U+10FFFF or truncated sequences. Uses the lookup-table
+ * algorithm of Keiser and Lemire with AVX2, and skips ASCII runs quickly
+ * on every path.
+ *
+ * @param error_offset If not NULL, receives the offset of the first byte
+ *      that does not start a valid character when validation fails.
+ * @return Whether buf is valid UTF-8.
+ */
+bool dawn_utf8_validate(const char *buf, size_t length, size_t *error_offset);
 
-    long f_size = ftell(f);
-    if (f_size < 0) {
-        perror("Failed to get the size of the file");
-        DAWN_DEFER_RETURN(false);
-    }
+/**
+ * Count the code points in valid UTF-8 text. On invalid input the result
+ * is the number of bytes that are not continuation bytes.
+ */
+size_t dawn_utf8_count(const char *buf, size_t length);
 
-    if (fseek(f, 0, SEEK_SET)) {
-        perror("Failed to get to the start of file");
-        DAWN_DEFER_RETURN(false);
-    }
+/**********
+ *Encoding*
+ **********/
 
-    buf = malloc(f_size);
-    if (!buf) {
-        fprintf(stderr, "Failed to allocate memory for content from %s\n", filepath);
-        DAWN_DEFER_RETURN(false);
-    }
+typedef enum {
+    // RFC 4648 base64 with '+', '/' and '=' padding.
+    DAWN_BASE64_STANDARD,
+    // RFC 4648 base64url with '-', '_' and no padding.
+    DAWN_BASE64_URL,
+} DawnBase64Alphabet;
 
-    size_t read_size = fread(buf, 1, f_size, f);
-    if (read_size < (size_t)f_size && ferror(f)) {
-        fprintf(stderr, "There was an error while reading %s\n", filepath);
-        DAWN_DEFER_RETURN(false);
-    }
+/**
+ * Append the base64 encoding of data to sb. The text is written straight
+ * into the reserved tail of sb, 24 (AVX2) or 12 (SSSE3) input bytes at a time.
+ */
+void dawn_sb_append_base64(DawnStringBuilder *sb, const void *data, size_t length, DawnBase64Alphabet alphabet);
 
-    DAWN_SB_APPEND_BUF(content, buf, f_size);
-    result = true;
+/**
+ * Decode base64 text and append the bytes to sb. Padding is optional, but
+ * the unused bits of the last character must be zero as RFC 4648 requires.
+ *
+ * @return Whether text was valid base64 in the given alphabet.
+ *      On failure the length of sb is left unchanged.
+ */
+bool dawn_sb_append_base64_decoded(DawnStringBuilder *sb, const char *text, size_t length, DawnBase64Alphabet alphabet);
 
-defer:
-    if (f) fclose(f);
-    if (buf) free(buf);
-    return result;
-}
+/**
+ * Append data as lowercase hexadecimal, two digits per byte.
+ */
+void dawn_sb_append_hex_bytes(DawnStringBuilder *sb, const void *data, size_t length);
 
-bool dawn_write_entire_file(const char *filepath, const DawnStringBuilder *content) {
-    if (!filepath || !content) return false;
+/**
+ * Decode hexadecimal text (either case) and append the bytes to sb.
+ *
+ * @return Whether text was an even number of hexadecimal digits.
+ *      On failure the length of sb is left unchanged.
+ */
+bool dawn_sb_append_hex_decoded(DawnStringBuilder *sb, const char *text, size_t length);
 
-    bool result;
+/****************
+ *Number parsing*
+ ****************/
 
-    FILE *f = fopen(filepath, "w+");
-    if (!f) {
-        perror("Failed to open file!");
-        DAWN_DEFER_RETURN(false);
-    }
+// These parse a number at the start of buf. The input does not need to be
+// NUL-terminated, leading whitespace is not skipped and the current locale
+// is ignored: the decimal separator is always '.'.
 
-    size_t size = fwrite(content->items, 1, content->length, f);
-    if (size < content->length) {
-        fprintf(stderr, "ERROR: There was an error when writing content to %s\n", filepath);
-        DAWN_DEFER_RETURN(false);
-    }
+/**
+ * Parse a decimal integer with an optional '+'. Unlike strtoull, a '-' is
+ * rejected, even in "-0".
+ *
+ * @return The number of bytes consumed, or 0 if buf does not start with
+ *      an integer or the integer does not fit. value is only written on success.
+ */
+size_t dawn_parse_u64(const char *buf, size_t length, uint64_t *value);
 
-    result = true;
+/**
+ * Parse a decimal integer with an optional '+' or '-'.
+ *
+ * @return The number of bytes consumed, or 0 if buf does not start with
+ *      an integer or the integer does not fit. value is only written on success.
+ */
+size_t dawn_parse_i64(const char *buf, size_t length, int64_t *value);
 
-defer:
-    if (f) {
-        fclose(f);
+/**
+ * Parse a decimal floating point number such as "-1.5e-3", ".5", "inf" or
+ * "nan", rounding correctly to the nearest double.
+ *
+ * @return The number of bytes consumed, or 0 if buf does not start with a number.
+ *      value is only written on success.
+ */
+size_t dawn_parse_f64(const char *buf, size_t length, double *value);
+
+/******
+ *JSON*
+ ******/
+
+/**
+ * Append str with the bytes JSON requires escaping (quote, backslash and
+ * control characters) escaped. The surrounding quotes are not added and
+ * everything else, including UTF-8 sequences, is copied unchanged.
+ */
+void dawn_sb_append_json_escaped(DawnStringBuilder *sb, const char *str, size_t length);
+
+/**
+ * Decode the escape sequences of a JSON string body, such as the text of a
+ * DAWN_JSON_STRING token, and append the result to sb. \u escapes, including
+ * surrogate pairs, are written as UTF-8.
+ *
+ * @return Whether the body was valid. On failure the length of sb is left unchanged.
+ */
+bool dawn_sb_append_json_unescaped(DawnStringBuilder *sb, const char *str, size_t length);
+
+typedef enum {
+    DAWN_JSON_END,
+    DAWN_JSON_ERROR,
+    DAWN_JSON_OBJECT_BEGIN,
+    DAWN_JSON_OBJECT_END,
+    DAWN_JSON_ARRAY_BEGIN,
+    DAWN_JSON_ARRAY_END,
+    DAWN_JSON_COLON,
+    DAWN_JSON_COMMA,
+    DAWN_JSON_STRING,
+    DAWN_JSON_NUMBER,
+    DAWN_JSON_TRUE,
+    DAWN_JSON_FALSE,
+    DAWN_JSON_NULL,
+} DawnJsonTokenKind;
+
+typedef struct {
+    DawnJsonTokenKind kind;
+    // Points into the tokenized buffer. For strings this is the body between
+    // the quotes, still escaped; for errors it is the offending byte.
+    DawnStringView text;
+    // Whether a string token contains escape sequences.
+    bool escaped;
+} DawnJsonToken;
+
+/**
+ * Pull tokenizer over a JSON buffer, e.g. one filled by dawn_read_entire_file.
+ * Tokens point into the buffer, so nothing is allocated while tokenizing.
+ * Only the lexical grammar is checked; matching brackets, commas and colons
+ * is left to the caller. Once an error is returned every later call returns it too.
+ */
+typedef struct {
+    const char *data;
+    size_t length;
+    size_t position;
+    bool failed;
+} DawnJsonTokenizer;
+
+#define DAWN_JSON_TOKENIZER_INIT(buf, buflen) {(buf), (buflen), 0, false}
+
+/**
+ * @return The next token. Returns DAWN_JSON_END once the input is exhausted.
+ */
+DawnJsonToken dawn_json_next(DawnJsonTokenizer *tk);
+
+/*****
+ *CSV*
+ *****/
+
+/**
+ * Reads delimiter-separated values (RFC 4180 CSV, or TSV with '\t') from a
+ * buffer such as one filled by dawn_read_entire_file. Fields are string views
+ * into the buffer; quoted fields keep their quotes, see dawn_csv_unquote.
+ * Records end at '\n' outside quotes, and a '\r' before it is dropped.
+ *
+ * The buffer is indexed 64 bytes at a time: quote, delimiter and newline
+ * bitmasks are built with SIMD compares and a prefix xor over the quote mask
+ * removes the separators that are inside quotes (see simdcsv by G. Langdale).
+ */
+typedef struct {
+    const char *data;
+    size_t length;
+    char delimiter;
+    size_t position;
+    // Separators not yet consumed in the block starting at block_start.
+    uint64_t separators;
+    size_t block_start;
+    size_t scanned;
+    // All ones when the last scanned block ended inside quotes.
+    uint64_t inside_quotes;
+    bool record_ended;
+    bool done;
+} DawnCsvReader;
+
+// Fields in declaration order, with only record_ended starting true.
+#define DAWN_CSV_READER_INIT(buf, buflen, delim) {(buf), (buflen), (delim), 0, 0, 0, 0, 0, true, false}
+
+/**
+ * Read the next field.
+ *
+ * @param end_of_record Set to whether field is the last one of its record.
+ * @return false once the input is exhausted.
+ */
+bool dawn_csv_next(DawnCsvReader *reader, DawnStringView *field, bool *end_of_record);
+
+/**
+ * Strip the quotes of a quoted field and collapse its doubled quotes.
+ * Unquoted fields and quoted fields without doubled quotes are returned as
+ * views into the input; otherwise scratch is cleared, the field is decoded
+ * into it and the result points into scratch.
+ */
+DawnStringView dawn_csv_unquote(DawnStringView field, DawnStringBuilder *scratch);
+
+/**
+ * Split data into at most count chunks that each start at a record boundary,
+ * so that every chunk can be read by its own reader, e.g. on its own thread.
+ * Quote parity is tracked so that newlines inside quoted fields are never
+ * used as boundaries.
+ *
+ * @param starts Receives the start offset of each chunk; chunk i ends where
+ *      chunk i + 1 starts, and the last one at length.
+ * @return The number of chunks, between 1 and count.
+ */
+size_t dawn_csv_split(const char *data, size_t length, size_t *starts, size_t count);
+
+/*********
+ *Hashing*
+ *********/
+
+// Inputs longer than this are hashed in 64 byte stripes, vectorized with AVX2.
+#define DAWN_HASH_LONG_INPUT 256
+
+/**
+ * State for hashing data that arrives in chunks. Feeding the same bytes in
+ * any chunking produces the same value as dawn_hash64.
+ */
+typedef struct {
+    uint64_t seed;
+    uint64_t total_length;
+    uint64_t acc[8];
+    uint64_t secret[24];
+    size_t stripe;
+    size_t buffered;
+    unsigned char buffer[DAWN_HASH_LONG_INPUT];
+    unsigned char last_stripe[64];
+} DawnHasher;
+
+#define DAWN_HASH_SB(sb, seed) dawn_hash64((sb)->items, (sb)->length, seed)
+#define DAWN_HASH_SV(sv, seed) dawn_hash64((sv).data, (sv).length, seed)
+
+/**
+ * Fast non-cryptographic 64-bit hash. Not suitable where an attacker
+ * controls the input and can observe the results.
+ *
+ * @param buf The data to hash.
+ * @param length The number of bytes in buf.
+ * @param seed Selects a different hash function.
+ * @return The hash of the data.
+ */
+uint64_t dawn_hash64(const void *buf, size_t length, uint64_t seed);
+
+/**
+ * Streaming interface to dawn_hash64.
+ */
+void dawn_hasher_init(DawnHasher *hasher, uint64_t seed);
+void dawn_hasher_update(DawnHasher *hasher, const void *buf, size_t length);
+uint64_t dawn_hasher_digest(const DawnHasher *hasher);
+
+/**********
+ *Hash map*
+ **********/
+
+/**
+ * Open-addressing hash map with SwissTable-style control bytes.
+ *
+ * Keys and values are stored by value in a single allocation whose capacity
+ * is always a power of two. Fixed-size keys are hashed and compared bytewise,
+ * so they must not contain padding. String-keyed maps copy each key into
+ * key_arena on insertion and never copy on lookup. The bytes of removed keys
+ * stay in the arena until it grows past twice key_bytes, the size of the live
+ * keys, at which point the next insertion compacts it.
+ *
+ * Set backward_shift before the first insertion to delete by shifting the
+ * following entries back instead of leaving tombstones.
+ */
+typedef struct {
+    size_t length;
+    size_t capacity;
+    size_t tombstones;
+    size_t key_size;
+    size_t value_size;
+    bool string_keys;
+    bool backward_shift;
+    uint8_t *ctrl;
+    char *items;
+    DawnStringBuilder key_arena;
+    size_t key_bytes;
+} DawnHashMap;
+
+// Where a string key lives inside DawnHashMap::key_arena.
+typedef struct {
+    size_t offset;
+    size_t length;
+} DawnHashMapStrKey;
+
+// Positional rather than designated initializers, which C++ only has since C++20.
+#define DAWN_HM_INIT(key_type, value_type) \
+    {0, 0, 0, sizeof(key_type), sizeof(value_type), false, false, NULL, NULL, {0, 0, NULL}, 0}
+
+#define DAWN_HM_STR_INIT(value_type) \
+    {0, 0, 0, sizeof(DawnHashMapStrKey), sizeof(value_type), true, false, NULL, NULL, {0, 0, NULL}, 0}
+
+#define DAWN_HM_FREE(hm)                 \
+    do {                                 \
+        free((hm).ctrl);                 \
+        DAWN_SB_FREE((hm).key_arena);    \
+    } while (0)
+
+#define DAWN_HM_GET_SB(hm, sb) dawn_hm_get_str(hm, (sb)->items, (sb)->length)
+#define DAWN_HM_PUT_SB(hm, sb, value) dawn_hm_put_str(hm, (sb)->items, (sb)->length, value)
+#define DAWN_HM_REMOVE_SB(hm, sb) dawn_hm_remove_str(hm, (sb)->items, (sb)->length)
+
+#define DAWN_HM_GET_SV(hm, sv) dawn_hm_get_str(hm, (sv).data, (sv).length)
+#define DAWN_HM_PUT_SV(hm, sv, value) dawn_hm_put_str(hm, (sv).data, (sv).length, value)
+#define DAWN_HM_REMOVE_SV(hm, sv) dawn_hm_remove_str(hm, (sv).data, (sv).length)
+
+/**
+ * Look up a fixed-size key.
+ *
+ * @return A pointer to the value, or NULL if the key is not present.
+ *      The pointer is invalidated by the next insertion or removal.
+ */
+void *dawn_hm_get(const DawnHashMap *hm, const void *key);
+
+/**
+ * Insert or overwrite a fixed-size key.
+ *
+ * @param value The value to copy in. When NULL, a new entry is zeroed and
+ *      an existing entry is left untouched.
+ * @return A pointer to the stored value.
+ */
+void *dawn_hm_put(DawnHashMap *hm, const void *key, const void *value);
+
+/**
+ * Remove a fixed-size key.
+ *
+ * @return Whether the key was present.
+ */
+bool dawn_hm_remove(DawnHashMap *hm, const void *key);
+
+/**
+ * String-keyed versions of the functions above. The key does not need to be
+ * NUL-terminated.
+ */
+void *dawn_hm_get_str(const DawnHashMap *hm, const char *key, size_t key_length);
+void *dawn_hm_put_str(DawnHashMap *hm, const char *key, size_t key_length, const void *value);
+bool dawn_hm_remove_str(DawnHashMap *hm, const char *key, size_t key_length);
+
+/**
+ * Make room for at least count entries without further rehashing.
+ */
+void dawn_hm_reserve(DawnHashMap *hm, size_t count);
+
+/**
+ * Iterate over the occupied slots:
+ *
+ *     for (size_t i = dawn_hm_next(&hm, 0); i < hm.capacity; i = dawn_hm_next(&hm, i + 1))
+ *
+ * @return The index of the first occupied slot at or after index,
+ *      or hm->capacity if there is none.
+ */
+size_t dawn_hm_next(const DawnHashMap *hm, size_t index);
+
+/**
+ * Access the entry in an occupied slot. For string-keyed maps, use
+ * dawn_hm_str_key_at instead of dawn_hm_key_at.
+ */
+void *dawn_hm_key_at(const DawnHashMap *hm, size_t index);
+const char *dawn_hm_str_key_at(const DawnHashMap *hm, size_t index, size_t *key_length);
+void *dawn_hm_value_at(const DawnHashMap *hm, size_t index);
+
+/**********
+ *Interner*
+ **********/
+
+/**
+ * Stores each distinct string once and hands out dense 32-bit ids, so that
+ * string equality becomes an integer compare. The bytes live in the arena of
+ * the underlying string-keyed map; items maps an id back to them.
+ */
+typedef struct {
+    DawnHashMap ids;
+    size_t length;
+    size_t capacity;
+    DawnHashMapStrKey *items;
+} DawnInterner;
+
+#define DAWN_INTERNER_INIT {DAWN_HM_STR_INIT(uint32_t), 0, 0, NULL}
+
+#define DAWN_INTERNER_FREE(in)     \
+    do {                           \
+        DAWN_HM_FREE((in).ids);    \
+        free((in).items);          \
+    } while (0)
+
+#define DAWN_INTERN_SB(in, sb) dawn_intern(in, (sb)->items, (sb)->length)
+#define DAWN_INTERN_SV(in, sv) dawn_intern(in, (sv).data, (sv).length)
+
+/**
+ * Intern a string. The string is hashed once and only copied the first time
+ * it is seen.
+ *
+ * @return The id of the string. Ids are assigned in order starting at 0.
+ */
+uint32_t dawn_intern(DawnInterner *in, const char *str, size_t length);
+
+/**
+ * Find the id of a string without interning it.
+ *
+ * @return Whether the string has been interned.
+ */
+bool dawn_intern_lookup(const DawnInterner *in, const char *str, size_t length, uint32_t *id);
+
+/**
+ * Get the string behind an id. The result is not NUL-terminated and is
+ * invalidated by the next call to dawn_intern.
+ */
+const char *dawn_interner_get(const DawnInterner *in, uint32_t id, size_t *length);
+
+/******
+ *Rope*
+ ******/
+
+typedef struct DawnRopeNode DawnRopeNode;
+
+/**
+ * Text stored as a balanced tree of chunks, for documents too large to edit
+ * with memmoves. Every node caches the length and number of newlines below
+ * it, so inserting, deleting, indexing and line lookups are O(log n).
+ * A zero-initialized DawnRope is empty.
+ */
+typedef struct {
+    DawnRopeNode *root;
+} DawnRope;
+
+#define DAWN_ROPE_FREE(rope) dawn_rope_free(&(rope))
+
+void dawn_rope_free(DawnRope *rope);
+
+size_t dawn_rope_length(const DawnRope *rope);
+
+/**
+ * @return The number of lines, which is one more than the number of '\n'.
+ */
+size_t dawn_rope_line_count(const DawnRope *rope);
+
+/**
+ * Insert str before the byte at index. index may be equal to the length.
+ */
+void dawn_rope_insert(DawnRope *rope, size_t index, const char *str, size_t length);
+
+/**
+ * Delete length bytes starting at index. The range is clamped to the rope.
+ */
+void dawn_rope_delete(DawnRope *rope, size_t index, size_t length);
+
+char dawn_rope_at(const DawnRope *rope, size_t index);
+
+/**
+ * @return The offset of the first byte of the given line (counting from 0),
+ *      or DAWN_NOT_FOUND if there are not that many lines.
+ */
+size_t dawn_rope_line_start(const DawnRope *rope, size_t line);
+
+/**
+ * @return The line (counting from 0) that contains the byte at index.
+ */
+size_t dawn_rope_line_at(const DawnRope *rope, size_t index);
+
+/**
+ * Append length bytes starting at index to sb. The range is clamped to the rope.
+ */
+void dawn_sb_append_rope(DawnStringBuilder *sb, const DawnRope *rope, size_t index, size_t length);
+
+/**
+ * Write the whole rope to a file without flattening it first. On POSIX
+ * systems the chunks are handed to writev in batches.
+ *
+ * @return Whether the file was written successfully.
+ */
+bool dawn_rope_write_entire_file(const char *filepath, const DawnRope *rope);
+
+/************
+ *Gap buffer*
+ ************/
+
+/**
+ * Text with a movable gap at the cursor, for cursor-local editing: typing
+ * and deleting next to the cursor is O(1), and moving the cursor memmoves
+ * only the bytes it passes over. The fields match a dynamic array, with the
+ * gap being the capacity - length spare bytes between cursor and the rest of
+ * the text, so it grows with the same logic as the DAWN_DA_* macros.
+ * A zero-initialized DawnGapBuffer is empty.
+ */
+typedef struct {
+    size_t length;
+    size_t capacity;
+    char *items;
+    size_t cursor;
+} DawnGapBuffer;
+
+#define DAWN_GB_FREE(gb) free((gb).items)
+
+static inline char dawn_gb_at(const DawnGapBuffer *gb, size_t index) {
+    assert(index < gb->length);
+    return index < gb->cursor ? gb->items[index] : gb->items[index + gb->capacity - gb->length];
+}
+
+/**
+ * Move the cursor to index, which may be equal to the length.
+ */
+void dawn_gb_move_cursor(DawnGapBuffer *gb, size_t index);
+
+/**
+ * Insert str at the cursor and move the cursor past it.
+ */
+void dawn_gb_insert(DawnGapBuffer *gb, const char *str, size_t length);
+
+/**
+ * Delete up to count bytes before (like backspace) or after the cursor.
+ */
+void dawn_gb_delete_before(DawnGapBuffer *gb, size_t count);
+void dawn_gb_delete_after(DawnGapBuffer *gb, size_t count);
+
+/**
+ * Append the text to sb, copying each side of the gap once.
+ */
+void dawn_sb_append_gap_buffer(DawnStringBuilder *sb, const DawnGapBuffer *gb);
+
+/**
+ * Close the gap at the end of the text and hand the allocation over to a
+ * string builder, leaving gb empty. Nothing before the cursor is copied.
+ */
+DawnStringBuilder dawn_gb_into_sb(DawnGapBuffer *gb);
+
+/**
+ * Take over the allocation of sb, leaving it empty. The cursor starts at the end.
+ */
+DawnGapBuffer dawn_gb_from_sb(DawnStringBuilder *sb);
+
+/********
+ *Random*
+ ********/
+
+typedef enum {
+    // xoshiro256++ by D. Blackman and S. Vigna: fast, 256 bits of state.
+    DAWN_RNG_XOSHIRO256PP,
+    // PCG64 (XSL RR 128/64) by M. O'Neill: 128-bit LCG with a permuted output.
+    DAWN_RNG_PCG64,
+} DawnRngKind;
+
+/**
+ * A pseudo random number generator with explicit state, so that every
+ * thread or task can own one instead of sharing the hidden state of rand().
+ * Not suitable for cryptography.
+ */
+typedef struct {
+    DawnRngKind kind;
+    // xoshiro256++: s0 to s3. PCG64: the low and high halves of the state,
+    // then of the increment.
+    uint64_t state[4];
+} DawnRng;
+
+/**
+ * Seed rng. The seed is expanded with splitmix64, so nearby seeds such as
+ * 1, 2, 3 still give unrelated sequences.
+ */
+void dawn_rng_seed(DawnRng *rng, DawnRngKind kind, uint64_t seed);
+
+/**
+ * @return The generator of the calling thread, seeded from the clock and
+ *      the thread on first use. Reseed it with dawn_rng_seed for reproducible runs.
+ */
+DawnRng *dawn_rng_default(void);
+
+uint64_t dawn_rng_u64(DawnRng *rng);
+
+/**
+ * @return A uniform float in [0, 1) with 24 random bits.
+ */
+float dawn_rng_float(DawnRng *rng);
+
+/**
+ * @return A uniform double in [0, 1) with 53 random bits.
+ */
+double dawn_rng_double(DawnRng *rng);
+
+/**
+ * @return A uniform integer in [0, n), without modulo bias. n must not be 0.
+ *      Uses D. Lemire's multiply-shift method, which needs a division only
+ *      in the rare case that a rejection is possible.
+ */
+uint64_t dawn_rng_bounded(DawnRng *rng, uint64_t n);
+
+/**
+ * @return A uniform integer in [min, max], without modulo bias.
+ */
+int64_t dawn_rng_range(DawnRng *rng, int64_t min, int64_t max);
+
+/**
+ * @return A normally distributed double with mean 0 and standard deviation 1.
+ *      Scale and shift it for other parameters.
+ */
+double dawn_rng_normal(DawnRng *rng);
+
+/**
+ * @return An exponentially distributed double with rate 1 (mean 1).
+ *      Divide it by the rate for other parameters.
+ */
+double dawn_rng_exponential(DawnRng *rng);
+
+/**
+ * Advance rng by 2^128 steps (xoshiro256++) or 2^64 steps (PCG64). Copies of
+ * one seeded generator jumped 0, 1, 2, ... times produce non-overlapping
+ * substreams, so work split over threads stays reproducible no matter how
+ * it is scheduled.
+ */
+void dawn_rng_jump(DawnRng *rng);
+
+/**
+ * Advance rng by 2^192 steps (xoshiro256++) or 2^96 steps (PCG64), e.g. to
+ * give every process its own range that is then divided with dawn_rng_jump.
+ */
+void dawn_rng_long_jump(DawnRng *rng);
+
+/**
+ * Set streams[i] to rng jumped i times, for one substream per worker.
+ * rng itself is not modified.
+ */
+void dawn_rng_split(const DawnRng *rng, DawnRng *streams, size_t count);
+
+/**
+ * Fill out with n random values. Large xoshiro256++ fills run eight
+ * interleaved generators, seeded from rng, in AVX2 registers when available,
+ * so the values differ from those of n calls to dawn_rng_u64 but are
+ * still fully determined by the state of rng.
+ */
+void dawn_rng_fill_u64(DawnRng *rng, uint64_t *out, size_t n);
+
+/**
+ * Fill out with n uniform floats in [0, 1). Bulk values are built by putting
+ * 23 random bits into the mantissa of a float in [1, 2) and subtracting 1,
+ * which avoids a division or int-to-float conversion per value.
+ */
+void dawn_rng_fill_float(DawnRng *rng, float *out, size_t n);
+
+/**
+ * Batch variants of dawn_rng_bounded, dawn_rng_normal and
+ * dawn_rng_exponential. The random bits come from dawn_rng_fill_u64 in
+ * chunks, so the results differ from calling the single-value functions n times.
+ */
+void dawn_rng_fill_bounded(DawnRng *rng, uint64_t *out, size_t count, uint64_t n);
+void dawn_rng_fill_normal(DawnRng *rng, double *out, size_t n);
+void dawn_rng_fill_exponential(DawnRng *rng, double *out, size_t n);
+
+/*********
+ *Divider*
+ *********/
+
+/**
+ * A precomputed divisor for dividing many numbers by the same n, e.g. ring
+ * indices or hash buckets. The division becomes a multiply-high, a
+ * subtraction and two shifts (Granlund and Montgomery), or a shift and a
+ * mask when n is a power of two.
+ *
+ * The signed functions round the quotient towards negative infinity, so the
+ * remainder is always in [0, n) like dawn_mod. They need n <= INT32_MAX
+ * (INT64_MAX for the 64-bit variant).
+ */
+typedef struct {
+    uint32_t divisor;
+    uint32_t magic;
+    uint8_t shift1;
+    uint8_t shift2;
+    bool power_of_two;
+} DawnDivider32;
+
+typedef struct {
+    uint64_t divisor;
+    uint64_t magic;
+    uint8_t shift1;
+    uint8_t shift2;
+    bool power_of_two;
+} DawnDivider64;
+
+/**
+ * Prepare d for dividing by n. n must not be 0.
+ */
+void dawn_divider32_init(DawnDivider32 *d, uint32_t n);
+void dawn_divider64_init(DawnDivider64 *d, uint64_t n);
+
+/**
+ * Set out[i] to dawn_mod(in[i], n) for count elements. out may equal in.
+ * With AVX2, eight elements are reduced at a time with the DawnDivider32
+ * multiply, which is much faster than a division per element.
+ */
+void dawn_mod_array(int *out, const int *in, size_t count, int n);
+
+static inline uint64_t dawn__mul128(uint64_t a, uint64_t b, uint64_t *hi) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t)a * b;
+    *hi = (uint64_t)(r >> 64);
+    return (uint64_t)r;
+#else
+    uint64_t lo_lo = (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF);
+    uint64_t hi_lo = (a >> 32) * (b & 0xFFFFFFFF);
+    uint64_t lo_hi = (a & 0xFFFFFFFF) * (b >> 32);
+    uint64_t hi_hi = (a >> 32) * (b >> 32);
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    *hi = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    return (cross << 32) | (lo_lo & 0xFFFFFFFF);
+#endif
+}
+
+static inline uint32_t dawn_div_u32(uint32_t x, const DawnDivider32 *d) {
+    if (d->power_of_two) return x >> d->shift2;
+    uint32_t t = (uint32_t)(((uint64_t)x * d->magic) >> 32);
+    return (t + ((x - t) >> d->shift1)) >> d->shift2;
+}
+
+static inline uint32_t dawn_mod_u32(uint32_t x, const DawnDivider32 *d) {
+    if (d->power_of_two) return x & (d->divisor - 1);
+    return x - dawn_div_u32(x, d)*d->divisor;
+}
+
+// floor(x/n) == ~(~x/n) for negative x, so both signs share the unsigned path.
+static inline int32_t dawn_div_i32(int32_t x, const DawnDivider32 *d) {
+    uint32_t sign = 0 - (uint32_t)(x < 0);
+    return (int32_t)(dawn_div_u32((uint32_t)x ^ sign, d) ^ sign);
+}
+
+static inline int32_t dawn_mod_i32(int32_t x, const DawnDivider32 *d) {
+    if (d->power_of_two) return (int32_t)((uint32_t)x & (d->divisor - 1));
+    return (int32_t)((uint32_t)x - (uint32_t)dawn_div_i32(x, d)*d->divisor);
+}
+
+static inline uint64_t dawn_div_u64(uint64_t x, const DawnDivider64 *d) {
+    if (d->power_of_two) return x >> d->shift2;
+    uint64_t t;
+    dawn__mul128(x, d->magic, &t);
+    return (t + ((x - t) >> d->shift1)) >> d->shift2;
+}
+
+static inline uint64_t dawn_mod_u64(uint64_t x, const DawnDivider64 *d) {
+    if (d->power_of_two) return x & (d->divisor - 1);
+    return x - dawn_div_u64(x, d)*d->divisor;
+}
+
+static inline int64_t dawn_div_i64(int64_t x, const DawnDivider64 *d) {
+    uint64_t sign = 0 - (uint64_t)(x < 0);
+    return (int64_t)(dawn_div_u64((uint64_t)x ^ sign, d) ^ sign);
+}
+
+static inline int64_t dawn_mod_i64(int64_t x, const DawnDivider64 *d) {
+    if (d->power_of_two) return (int64_t)((uint64_t)x & (d->divisor - 1));
+    return (int64_t)((uint64_t)x - (uint64_t)dawn_div_i64(x, d)*d->divisor);
+}
+
+/*********
+ *Sorting*
+ *********/
+
+typedef enum {
+    DAWN_RADIX_U32,
+    DAWN_RADIX_U64,
+    DAWN_RADIX_I32,
+    DAWN_RADIX_I64,
+    // IEEE floats: -0.0 sorts before 0.0, NaNs go to the ends by their sign bit.
+    DAWN_RADIX_F32,
+    DAWN_RADIX_F64,
+} DawnRadixKey;
+
+/**
+ * Stable LSD radix sort of count items of item_size bytes each, ordered by
+ * the key of type key stored key_offset bytes into every item. Runs one
+ * counting pass for all digits, then one scatter pass per byte of the key,
+ * skipping bytes that are equal in all keys (e.g. the high bytes of small
+ * numbers).
+ *
+ * @param scratch Room for count items, or NULL to malloc it for the call.
+ */
+void dawn_radix_sort(void *items, size_t count, size_t item_size, size_t key_offset, DawnRadixKey key, void *scratch);
+
+// Sort a dynamic array whose items are keys, e.g. DAWN_DA_RADIX_SORT(&ids, DAWN_RADIX_U64).
+#define DAWN_DA_RADIX_SORT(da, key) \
+    dawn_radix_sort((da)->items, (da)->length, sizeof *(da)->items, 0, (key), NULL)
+
+// Sort a dynamic array of structs by one field, e.g. DAWN_DA_RADIX_SORT_BY(&people, Person, age, DAWN_RADIX_I32).
+#define DAWN_DA_RADIX_SORT_BY(da, type, field, key) \
+    dawn_radix_sort((da)->items, (da)->length, sizeof *(da)->items, offsetof(type, field), (key), NULL)
+
+#if defined(__cplusplus) && __cplusplus >= 201103L
+#define DAWN__MOVE(x) std::move(x)
+#define DAWN__SORT_BRANCHLESS(type) (sizeof(type) <= 16 && std::is_trivially_copyable<type>::value)
+// dawn_parallel_sort merges into raw scratch memory and copies it back with memcpy.
+#define DAWN__ASSERT_TRIVIALLY_COPYABLE(type) \
+    static_assert(std::is_trivially_copyable<type>::value, "parallel sort needs trivially copyable items")
+#else
+#define DAWN__MOVE(x) (x)
+#define DAWN__SORT_BRANCHLESS(type) (sizeof(type) <= 16)
+#define DAWN__ASSERT_TRIVIALLY_COPYABLE(type) ((void)0)
+#endif
+
+// Pattern-defeating quicksort (O. Peters): median-of-3 or ninther pivots,
+// insertion sort for short ranges and already sorted runs, and heapsort
+// once too many partitions came out unbalanced, so it stays O(n log n).
+#define DAWN__SORT_BODY(qual, prefix, type)                                                          \
+    qual void prefix##_swap(type *a, type *b) {                                                      \
+        type temp = DAWN__MOVE(*a);                                                                  \
+        *a = DAWN__MOVE(*b);                                                                         \
+        *b = DAWN__MOVE(temp);                                                                       \
+    }                                                                                                \
+                                                                                                     \
+    qual void prefix##_sort2(type *a, type *b) {                                                     \
+        if (prefix##_less(b, a)) prefix##_swap(a, b);                                                \
+    }                                                                                                \
+                                                                                                     \
+    qual void prefix##_sort3(type *a, type *b, type *c) {                                            \
+        prefix##_sort2(a, b);                                                                        \
+        prefix##_sort2(b, c);                                                                        \
+        prefix##_sort2(a, b);                                                                        \
+    }                                                                                                \
+                                                                                                     \
+    /* With guarded false, begin[-1] must not be greater than any item. */                           \
+    qual void prefix##_insertion_sort(type *begin, type *end, bool guarded) {                        \
+        if (begin == end) return;                                                                    \
+        for (type *cur = begin + 1; cur != end; ++cur) {                                             \
+            type *sift = cur;                                                                        \
+            type *sift_1 = cur - 1;                                                                  \
+            if (prefix##_less(sift, sift_1)) {                                                       \
+                type temp = DAWN__MOVE(*sift);                                                       \
+                do {                                                                                 \
+                    *sift-- = DAWN__MOVE(*sift_1);                                                   \
+                } while ((!guarded || sift != begin) && prefix##_less(&temp, --sift_1));             \
+                *sift = DAWN__MOVE(temp);                                                            \
+            }                                                                                        \
+        }                                                                                            \
+    }                                                                                                \
+                                                                                                     \
+    /* Gives up after moving 8 items, for inputs that only look sorted. */                           \
+    qual bool prefix##_partial_insertion_sort(type *begin, type *end) {                              \
+        if (begin == end) return true;                                                               \
+        size_t moves = 0;                                                                            \
+        for (type *cur = begin + 1; cur != end; ++cur) {                                             \
+            type *sift = cur;                                                                        \
+            type *sift_1 = cur - 1;                                                                  \
+            if (prefix##_less(sift, sift_1)) {                                                       \
+                type temp = DAWN__MOVE(*sift);                                                       \
+                do {                                                                                 \
+                    *sift-- = DAWN__MOVE(*sift_1);                                                   \
+                } while (sift != begin && prefix##_less(&temp, --sift_1));                           \
+                *sift = DAWN__MOVE(temp);                                                            \
+                moves += (size_t)(cur - sift);                                                       \
+            }                                                                                        \
+            if (moves > 8) return false;                                                             \
+        }                                                                                            \
+        return true;                                                                                 \
+    }                                                                                                \
+                                                                                                     \
+    qual void prefix##_sift_down(type *items, size_t root, size_t count) {                           \
+        for (;;) {                                                                                   \
+            size_t child = 2*root + 1;                                                               \
+            if (child >= count) return;                                                              \
+            if (child + 1 < count && prefix##_less(&items[child], &items[child + 1])) child++;       \
+            if (!prefix##_less(&items[root], &items[child])) return;                                 \
+            prefix##_swap(&items[root], &items[child]);                                              \
+            root = child;                                                                            \
+        }                                                                                            \
+    }                                                                                                \
+                                                                                                     \
+    qual void prefix##_heapsort(type *items, size_t count) {                                         \
+        for (size_t i = count/2; i > 0; --i) prefix##_sift_down(items, i - 1, count);                \
+        for (size_t i = count; i > 1; --i) {                                                         \
+            prefix##_swap(&items[0], &items[i - 1]);                                                 \
+            prefix##_sift_down(items, 0, i - 1);                                                     \
+        }                                                                                            \
+    }                                                                                                \
+                                                                                                     \
+    /* Put items equal to the pivot *begin on its left, returns the pivot position. */               \
+    qual type *prefix##_partition_left(type *begin, type *end) {                                     \
+        type pivot = DAWN__MOVE(*begin);                                                             \
+        type *first = begin;                                                                         \
+        type *last = end;                                                                            \
+        while (prefix##_less(&pivot, --last));                                                       \
+        if (last + 1 == end) {                                                                       \
+            while (first < last && !prefix##_less(&pivot, ++first));                                 \
+        } else {                                                                                     \
+            while (!prefix##_less(&pivot, ++first));                                                 \
+        }                                                                                            \
+        while (first < last) {                                                                       \
+            prefix##_swap(first, last);                                                              \
+            while (prefix##_less(&pivot, --last));                                                   \
+            while (!prefix##_less(&pivot, ++first));                                                 \
+        }                                                                                            \
+        *begin = DAWN__MOVE(*last);                                                                  \
+        *last = DAWN__MOVE(pivot);                                                                   \
+        return last;                                                                                 \
+    }                                                                                                \
+                                                                                                     \
+    /*                                                                                               \
+     * Put items equal to the pivot *begin on its right, returns the pivot position.                 \
+     * Small items are partitioned in blocks of 64: the comparisons only record                      \
+     * offsets, which avoids a mispredicted branch per item (Edelkamp and Weiss).                    \
+     */                                                                                              \
+    qual type *prefix##_partition_right(type *begin, type *end, bool *already_partitioned) {         \
+        type pivot = DAWN__MOVE(*begin);                                                             \
+        type *first = begin;                                                                         \
+        type *last = end;                                                                            \
+        while (prefix##_less(++first, &pivot));                                                      \
+        if (first - 1 == begin) {                                                                    \
+            while (first < last && !prefix##_less(--last, &pivot));                                  \
+        } else {                                                                                     \
+            while (!prefix##_less(--last, &pivot));                                                  \
+        }                                                                                            \
+        *already_partitioned = first >= last;                                                        \
+        if (!*already_partitioned && !DAWN__SORT_BRANCHLESS(type)) {                                 \
+            while (first < last) {                                                                   \
+                prefix##_swap(first, last);                                                          \
+                while (prefix##_less(++first, &pivot));                                              \
+                while (!prefix##_less(--last, &pivot));                                              \
+            }                                                                                        \
+        } else if (!*already_partitioned) {                                                          \
+            prefix##_swap(first, last);                                                              \
+            ++first;                                                                                 \
+            unsigned char offsets_l[64];                                                             \
+            unsigned char offsets_r[64];                                                             \
+            type *base_l = first;                                                                    \
+            type *base_r = last;                                                                     \
+            size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;                                   \
+            while (first < last) {                                                                   \
+                size_t unknown = (size_t)(last - first);                                             \
+                size_t split_l = num_l == 0 ? (num_r == 0 ? unknown/2 : unknown) : 0;                \
+                size_t split_r = num_r == 0 ? unknown - split_l : 0;                                 \
+                if (split_l > 64) split_l = 64;                                                      \
+                if (split_r > 64) split_r = 64;                                                      \
+                for (size_t i = 0; i < split_l; ++i) {                                               \
+                    offsets_l[num_l] = (unsigned char)i;                                             \
+                    num_l += !prefix##_less(first, &pivot);                                          \
+                    ++first;                                                                         \
+                }                                                                                    \
+                for (size_t i = 0; i < split_r; ++i) {                                               \
+                    offsets_r[num_r] = (unsigned char)(i + 1);                                       \
+                    num_r += prefix##_less(--last, &pivot);                                          \
+                }                                                                                    \
+                size_t num = num_l < num_r ? num_l : num_r;                                          \
+                for (size_t i = 0; i < num; ++i) {                                                   \
+                    prefix##_swap(base_l + offsets_l[start_l + i], base_r - offsets_r[start_r + i]); \
+                }                                                                                    \
+                num_l -= num;                                                                        \
+                num_r -= num;                                                                        \
+                start_l += num;                                                                      \
+                start_r += num;                                                                      \
+                if (num_l == 0) {                                                                    \
+                    start_l = 0;                                                                     \
+                    base_l = first;                                                                  \
+                }                                                                                    \
+                if (num_r == 0) {                                                                    \
+                    start_r = 0;                                                                     \
+                    base_r = last;                                                                   \
+                }                                                                                    \
+            }                                                                                        \
+            if (num_l) {                                                                             \
+                while (num_l--) prefix##_swap(base_l + offsets_l[start_l + num_l], --last);          \
+                first = last;                                                                        \
+            }                                                                                        \
+            if (num_r) {                                                                             \
+                while (num_r--) prefix##_swap(base_r - offsets_r[start_r + num_r], first++);         \
+            }                                                                                        \
+        }                                                                                            \
+        type *pivot_pos = first - 1;                                                                 \
+        *begin = DAWN__MOVE(*pivot_pos);                                                             \
+        *pivot_pos = DAWN__MOVE(pivot);                                                              \
+        return pivot_pos;                                                                            \
+    }                                                                                                \
+                                                                                                     \
+    qual void prefix##_loop(type *begin, type *end, int bad_allowed, bool leftmost) {                \
+        for (;;) {                                                                                   \
+            size_t size = (size_t)(end - begin);                                                     \
+            if (size < 24) {                                                                         \
+                prefix##_insertion_sort(begin, end, leftmost);                                       \
+                return;                                                                              \
+            }                                                                                        \
+            size_t half = size/2;                                                                    \
+            if (size > 128) {                                                                        \
+                prefix##_sort3(begin, begin + half, end - 1);                                        \
+                prefix##_sort3(begin + 1, begin + half - 1, end - 2);                                \
+                prefix##_sort3(begin + 2, begin + half + 1, end - 3);                                \
+                prefix##_sort3(begin + half - 1, begin + half, begin + half + 1);                    \
+                prefix##_swap(begin, begin + half);                                                  \
+            } else {                                                                                 \
+                prefix##_sort3(begin + half, begin, end - 1);                                        \
+            }                                                                                        \
+            /* Equal to the item left of this range, so no item is smaller. */                       \
+            if (!leftmost && !prefix##_less(begin - 1, begin)) {                                     \
+                begin = prefix##_partition_left(begin, end) + 1;                                     \
+                continue;                                                                            \
+            }                                                                                        \
+            bool already_partitioned;                                                                \
+            type *pivot = prefix##_partition_right(begin, end, &already_partitioned);                \
+            size_t size_l = (size_t)(pivot - begin);                                                 \
+            size_t size_r = (size_t)(end - (pivot + 1));                                             \
+            if (size_l < size/8 || size_r < size/8) {                                                \
+                if (--bad_allowed == 0) {                                                            \
+                    prefix##_heapsort(begin, size);                                                  \
+                    return;                                                                          \
+                }                                                                                    \
+                /* Break up patterns that keep producing bad pivots. */                              \
+                if (size_l >= 24) {                                                                  \
+                    prefix##_swap(begin, begin + size_l/4);                                          \
+                    prefix##_swap(pivot - 1, pivot - size_l/4);                                      \
+                    if (size_l > 128) {                                                              \
+                        prefix##_swap(begin + 1, begin + size_l/4 + 1);                              \
+                        prefix##_swap(begin + 2, begin + size_l/4 + 2);                              \
+                        prefix##_swap(pivot - 2, pivot - (size_l/4 + 1));                            \
+                        prefix##_swap(pivot - 3, pivot - (size_l/4 + 2));                            \
+                    }                                                                                \
+                }                                                                                    \
+                if (size_r >= 24) {                                                                  \
+                    prefix##_swap(pivot + 1, pivot + 1 + size_r/4);                                  \
+                    prefix##_swap(end - 1, end - size_r/4);                                          \
+                    if (size_r > 128) {                                                              \
+                        prefix##_swap(pivot + 2, pivot + 2 + size_r/4);                              \
+                        prefix##_swap(pivot + 3, pivot + 3 + size_r/4);                              \
+                        prefix##_swap(end - 2, end - (1 + size_r/4));                                \
+                        prefix##_swap(end - 3, end - (2 + size_r/4));                                \
+                    }                                                                                \
+                }                                                                                    \
+            } else if (already_partitioned && prefix##_partial_insertion_sort(begin, pivot) &&       \
+                       prefix##_partial_insertion_sort(pivot + 1, end)) {                            \
+                return;                                                                              \
+            }                                                                                        \
+            prefix##_loop(begin, pivot, bad_allowed, leftmost);                                      \
+            begin = pivot + 1;                                                                       \
+            leftmost = false;                                                                        \
+        }                                                                                            \
+    }                                                                                                \
+                                                                                                     \
+    qual void prefix##_sort(type *items, size_t count) {                                             \
+        if (count < 2) return;                                                                       \
+        int depth = 0;                                                                               \
+        for (size_t n = count; n >>= 1;) depth++;                                                    \
+        prefix##_loop(items, items + count, depth, true);                                            \
+    }                                                                                                \
+                                                                                                     \
+    qual void prefix##_merge(const type *a, size_t count_a, const type *b, size_t count_b, type *out) {\
+        /* Stable: on ties the item from a comes first. */                                           \
+        size_t i = 0, j = 0;                                                                         \
+        while (i < count_a && j < count_b) {                                                         \
+            bool take_b = prefix##_less(&b[j], &a[i]);                                               \
+            *out++ = take_b ? b[j] : a[i];                                                           \
+            j += take_b;                                                                             \
+            i += !take_b;                                                                            \
+        }                                                                                            \
+        while (i < count_a) *out++ = a[i++];                                                         \
+        while (j < count_b) *out++ = b[j++];                                                         \
+    }                                                                                                \
+                                                                                                     \
+    qual size_t prefix##_lower_bound(const type *items, size_t count, const type *key) {             \
+        /* Branch-free binary search, the comparison only selects the next base. */                  \
+        if (count == 0) return 0;                                                                    \
+        const type *base = items;                                                                    \
+        for (size_t n = count; n > 1;) {                                                             \
+            size_t half = n/2;                                                                       \
+            base += half & (0 - (size_t)prefix##_less(&base[half - 1], key));                        \
+            n -= half;                                                                               \
+        }                                                                                            \
+        return (size_t)(base - items) + prefix##_less(base, key);                                    \
+    }
+
+typedef struct {
+    size_t item_size;
+    void (*sort)(void *items, size_t count);
+    bool (*less)(const void *a, const void *b);
+    // Stable merge of two sorted runs into out.
+    void (*merge)(const void *a, size_t count_a, const void *b, size_t count_b, void *out);
+} DawnSortFunctions;
+
+/**
+ * Sort count items with up to thread_count threads, 0 meaning one per
+ * online CPU. Fixed-size runs are sorted with functions->sort, then merged
+ * pairwise level by level, each merge split into equal pieces at positions
+ * found by binary search. Threads take pieces from their own queue and
+ * steal from the others when it runs dry. Run and piece boundaries depend
+ * only on count, so the result is the same for every thread count.
+ * Threads are only used when the implementation is compiled with
+ * DAWN_WITH_THREADS on a pthreads system (link with -pthread), otherwise
+ * it sorts on the calling thread.
+ */
+void dawn_parallel_sort(void *items, size_t count, const DawnSortFunctions *functions, size_t thread_count);
+
+/**
+ * Define static inline name_sort(type *items, size_t count), an unstable
+ * pdqsort ordered by less, an expression over the pointers a and b that
+ * is true when *a sorts before *b. The comparison is inlined, unlike the
+ * function pointer of qsort. Helpers named name_* are defined as well,
+ * among them name_merge, name_lower_bound(items, count, &key) for arrays
+ * sorted by name_sort and name_parallel_sort(items, count, thread_count).
+ *
+ * DAWN_DEFINE_SORT(points_by_x, Point, a->x < b->x)
+ * DAWN_DA_SORT(&points, points_by_x);
+ */
+#define DAWN_DEFINE_SORT(name, type, less)                                                                           \
+    static inline bool name##_less(const type *a, const type *b) { return (less); }                                  \
+    DAWN__SORT_BODY(static inline, name, type)                                                                       \
+    static inline void name##_sort_items(void *items, size_t count) {                                                \
+        name##_sort((type *)items, count);                                                                           \
+    }                                                                                                                \
+    static inline bool name##_less_items(const void *a, const void *b) {                                             \
+        return name##_less((const type *)a, (const type *)b);                                                        \
+    }                                                                                                                \
+    static inline void name##_merge_items(const void *a, size_t count_a, const void *b, size_t count_b, void *out) { \
+        name##_merge((const type *)a, count_a, (const type *)b, count_b, (type *)out);                               \
+    }                                                                                                                \
+    static inline void name##_parallel_sort(type *items, size_t count, size_t thread_count) {                        \
+        DAWN__ASSERT_TRIVIALLY_COPYABLE(type);                                                                       \
+        DawnSortFunctions functions = {sizeof(type), name##_sort_items, name##_less_items, name##_merge_items};      \
+        dawn_parallel_sort(items, count, &functions, thread_count);                                                  \
+    }
+
+#define DAWN_DA_SORT(da, name) name##_sort((da)->items, (da)->length)
+#define DAWN_DA_PARALLEL_SORT(da, name, thread_count) name##_parallel_sort((da)->items, (da)->length, (thread_count))
+
+/**
+ * @return The index of the first item of the sorted array that is not less
+ *      than key, or count if there is none. The search halves the range
+ *      with a conditional move instead of a branch, so it does not stall on
+ *      mispredictions, and prefetches both candidates of the next step.
+ */
+size_t dawn_lower_bound_u32(const uint32_t *items, size_t count, uint32_t key);
+size_t dawn_lower_bound_u64(const uint64_t *items, size_t count, uint64_t key);
+
+/**
+ * A copy of a sorted array in Eytzinger (breadth-first heap) order, where
+ * the children of keys[k] are keys[2k] and keys[2k + 1]. The first levels
+ * share cache lines and the next ones can be prefetched, which makes
+ * lookups in arrays larger than the cache several times faster than a
+ * binary search. Built once, it does not follow changes of the array.
+ */
+typedef struct {
+    size_t length;
+    // keys[1] to keys[length], keys[0] is unused.
+    uint32_t *keys;
+    // Index in the sorted array of every key. Owns the allocation of keys.
+    size_t *ranks;
+} DawnEytzinger32;
+
+typedef struct {
+    size_t length;
+    uint64_t *keys;
+    size_t *ranks;
+} DawnEytzinger64;
+
+#define DAWN_EYTZINGER_FREE(index) free((index).ranks)
+
+void dawn_eytzinger32_build(DawnEytzinger32 *index, const uint32_t *sorted, size_t count);
+void dawn_eytzinger64_build(DawnEytzinger64 *index, const uint64_t *sorted, size_t count);
+
+/**
+ * @return The same index as dawn_lower_bound_u32 on the sorted array.
+ */
+size_t dawn_eytzinger32_lower_bound(const DawnEytzinger32 *index, uint32_t key);
+size_t dawn_eytzinger64_lower_bound(const DawnEytzinger64 *index, uint64_t key);
+
+/**
+ * A static B-tree over a sorted array of u32 keys: nodes of 16 keys, one
+ * cache line, with 17 children each. A lookup compares the key with a whole
+ * node at once (two AVX2 or four SSE2 compares) and visits only
+ * log17(n) nodes, e.g. 6 for 10 million keys.
+ */
+typedef struct {
+    size_t length;
+    size_t node_count;
+    // 16 keys per node with the sign bit flipped for signed SIMD compares.
+    uint32_t *keys;
+    // Index in the sorted array of every key. Owns the allocation of keys.
+    size_t *ranks;
+} DawnBTree32;
+
+#define DAWN_BTREE_FREE(tree) free((tree).ranks)
+
+void dawn_btree32_build(DawnBTree32 *tree, const uint32_t *sorted, size_t count);
+
+/**
+ * @return The same index as dawn_lower_bound_u32 on the sorted array.
+ */
+size_t dawn_btree32_lower_bound(const DawnBTree32 *tree, uint32_t key);
+
+// The templates need lambdas, so C++98 builds only get the C interface.
+#if defined(__cplusplus) && __cplusplus >= 201103L
+template <typename T, typename Less>
+struct DawnSorter {
+    Less less_fn;
+    bool dawn__pdq_less(const T *a, const T *b) { return less_fn(*a, *b); }
+    DAWN__SORT_BODY(, dawn__pdq, T)
+};
+
+// The same pdqsort for C++, with a comparator object such as a lambda.
+template <typename T, typename Less>
+inline void dawn_sort(T *items, size_t count, Less less) {
+    DawnSorter<T, Less> sorter = {less};
+    sorter.dawn__pdq_sort(items, count);
+}
+
+template <typename T>
+inline void dawn_sort(T *items, size_t count) {
+    dawn_sort(items, count, [](const T &a, const T &b) { return a < b; });
+}
+#endif
+
+/******************
+ *Static functions*
+ ******************/
+
+// Use DawnDivider32 and dawn_mod_i32 when dividing many numbers by the same n.
+static inline int dawn_mod(int x, int n) {
+    return ((x%n) + n) % n;
+}
+
+// Uses the generator of the calling thread rather than rand(), see dawn_rng_default.
+static inline float dawn_rand_float() {
+    return dawn_rng_float(dawn_rng_default());
+}
+
+/***********
+ *Functions*
+ ***********/
+
+/**
+ * Shift out a command line arg.
+ */
+char *dawn_shift_args(int *argc, char ***argv);
+
+/**
+ * Read the contents of the given file.
+ *
+ * @param filepath The path to the file to be read.
+ * @param content The contents of the file will be appended to this StringBuilder.
+ * @return Whether the process was successful.
+ *      When a failure occurs, an error message is printed to stderr.
+ */
+bool dawn_read_entire_file(const char *filepath, DawnStringBuilder *content);
+
+/**
+ * Write the content to the given file.
+ *
+ * @param filepath The path to the file to be written to.
+ * @param content The content that is to be written to the file.
+ * @return Whether the process was successful.
+ *      When a failure occurs, an error message is printed to stderr.
+ */
+bool dawn_write_entire_file(const char *filepath, const DawnStringBuilder *content);
+
+#endif // DAWN_H_
+
+#ifdef DAWN_IMPLEMENTATION
+
+#if defined(__unix__) || defined(__APPLE__)
+#define DAWN__HAS_WRITEV
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+// Define DAWN_WITH_THREADS to let dawn_parallel_sort start threads, the
+// program then has to be linked with -pthread.
+#if defined(DAWN_WITH_THREADS) && (defined(__unix__) || defined(__APPLE__))
+#define DAWN__HAS_PTHREAD
+#include <pthread.h>
+#endif
+#include <time.h>
+
+char *dawn_shift_args(int *argc, char ***argv) {
+    assert(*argc > 0);
+    char *arg = **argv;
+    (*argv)++;
+    (*argc)--;
+    return arg;
+}
+
+bool dawn_read_entire_file(const char *filepath, DawnStringBuilder *content) {
+    if (!filepath || !content) return 0;
+
+    bool result;
+
+    FILE *f = NULL;
+    char *buf = NULL;
+
+    f = fopen(filepath, "r");
+    if (!f) {
+        fprintf(stderr, "Failed to open file: %s\n", filepath);
+        DAWN_DEFER_RETURN(false);
+    }
+
+    if (fseek(f, 0, SEEK_END)) {
+        perror("Failed to get to the end of file");
+        DAWN_DEFER_RETURN(false);
+    }
+
+    long f_size = ftell(f);
+    if (f_size < 0) {
+        perror("Failed to get the size of the file");
+        DAWN_DEFER_RETURN(false);
+    }
+
+    if (fseek(f, 0, SEEK_SET)) {
+        perror("Failed to get to the start of file");
+        DAWN_DEFER_RETURN(false);
+    }
+
+    buf = malloc(f_size);
+    if (!buf) {
+        fprintf(stderr, "Failed to allocate memory for content from %s\n", filepath);
+        DAWN_DEFER_RETURN(false);
+    }
+
+    size_t read_size = fread(buf, 1, f_size, f);
+    if (read_size < (size_t)f_size && ferror(f)) {
+        fprintf(stderr, "There was an error while reading %s\n", filepath);
+        DAWN_DEFER_RETURN(false);
+    }
+
+    DAWN_SB_APPEND_BUF(content, buf, f_size);
+    result = true;
+
+defer:
+    if (f) fclose(f);
+    if (buf) free(buf);
+    return result;
+}
+
+bool dawn_write_entire_file(const char *filepath, const DawnStringBuilder *content) {
+    if (!filepath || !content) return false;
+
+    bool result;
+
+    FILE *f = fopen(filepath, "w+");
+    if (!f) {
+        perror("Failed to open file!");
+        DAWN_DEFER_RETURN(false);
+    }
+
+    size_t size = fwrite(content->items, 1, content->length, f);
+    if (size < content->length) {
+        fprintf(stderr, "ERROR: There was an error when writing content to %s\n", filepath);
+        DAWN_DEFER_RETURN(false);
+    }
+
+    result = true;
+
+defer:
+    if (f) {
+        fclose(f);
+    }
+    return result;
+}
+
+/****************
+ *String builder*
+ ****************/
+
+int dawn_sb_appendf(DawnStringBuilder *sb, const char *fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int n = dawn_sb_vappendf(sb, fmt, args);
+    va_end(args);
+    return n;
+}
+
+int dawn_sb_vappendf(DawnStringBuilder *sb, const char *fmt, va_list args) {
+    va_list retry;
+    va_copy(retry, args);
+
+    size_t spare = sb->capacity - sb->length;
+    int n = vsnprintf(spare ? sb->items + sb->length : NULL, spare, fmt, args);
+    if (n >= 0 && (size_t)n >= spare) {
+        DAWN_DA_RESERVE(sb, (size_t)n);
+        vsnprintf(sb->items + sb->length, sb->capacity - sb->length, fmt, retry);
+    }
+    va_end(retry);
+
+    if (n > 0) sb->length += n;
+    return n;
+}
+
+/************
+ *Bit tricks*
+ ************/
+
+// The ctz and clz helpers are only defined for nonzero x.
+static inline unsigned dawn__ctz32(uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctz(x);
+#else
+    unsigned n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static inline unsigned dawn__ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(x);
+#else
+    unsigned n = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static inline unsigned dawn__clz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_clzll(x);
+#else
+    unsigned n = 0;
+    while (!(x & 0x8000000000000000ull)) {
+        x <<= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+static inline unsigned dawn__popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ull);
+    x = (x & 0x3333333333333333ull) + ((x >> 2) & 0x3333333333333333ull);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+    return (unsigned)((x * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+static inline uint64_t dawn__read64(const unsigned char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof v);
+    return v;
+}
+
+static inline uint64_t dawn__read32(const unsigned char *p) {
+    uint32_t v;
+    memcpy(&v, p, sizeof v);
+    return v;
+}
+
+/****************
+ *Number to text*
+ ****************/
+
+static const char dawn__digit_pairs[201] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+static const uint64_t dawn__pow10_u64[20] = {
+    1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull,
+    1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull,
+    100000000000000ull, 1000000000000000ull, 10000000000000000ull, 100000000000000000ull,
+    1000000000000000000ull, 10000000000000000000ull,
+};
+
+static inline size_t dawn__count_digits(uint64_t value) {
+    // Or-ing in 1 makes 0 count as one digit without changing other counts.
+    value |= 1;
+    // 1233/4096 approximates log10(2).
+    size_t digits = (size_t)((64 - dawn__clz64(value)) * 1233) >> 12;
+    return digits + (digits < 20 && value >= dawn__pow10_u64[digits]);
+}
+
+// Writes the digits of value so that they end right before end.
+static inline void dawn__write_u32(char *end, uint32_t value) {
+    while (value >= 100) {
+        uint32_t pair = value % 100;
+        value /= 100;
+        end -= 2;
+        memcpy(end, dawn__digit_pairs + 2 * pair, 2);
+    }
+    if (value >= 10) {
+        memcpy(end - 2, dawn__digit_pairs + 2 * value, 2);
+    } else {
+        end[-1] = (char)('0' + value);
+    }
+}
+
+static inline void dawn__write_u64(char *end, uint64_t value) {
+    // Peel off 8 digits at a time so that the pair loop runs on 32-bit values.
+    while (value > 0xFFFFFFFF) {
+        uint32_t low = (uint32_t)(value % 100000000);
+        value /= 100000000;
+        for (int i = 0; i < 4; i++) {
+            end -= 2;
+            memcpy(end, dawn__digit_pairs + 2 * (low % 100), 2);
+            low /= 100;
+        }
+    }
+    dawn__write_u32(end, (uint32_t)value);
+}
+
+void dawn_sb_append_u32(DawnStringBuilder *sb, uint32_t value) {
+    size_t digits = dawn__count_digits(value);
+    DAWN_DA_RESERVE(sb, digits);
+    dawn__write_u32(sb->items + sb->length + digits, value);
+    sb->length += digits;
+}
+
+void dawn_sb_append_u64(DawnStringBuilder *sb, uint64_t value) {
+    size_t digits = dawn__count_digits(value);
+    DAWN_DA_RESERVE(sb, digits);
+    dawn__write_u64(sb->items + sb->length + digits, value);
+    sb->length += digits;
+}
+
+void dawn_sb_append_i64(DawnStringBuilder *sb, int64_t value) {
+    uint64_t magnitude = value < 0 ? 0 - (uint64_t)value : (uint64_t)value;
+    size_t length = dawn__count_digits(magnitude) + (value < 0);
+    DAWN_DA_RESERVE(sb, length);
+    if (value < 0) sb->items[sb->length] = '-';
+    dawn__write_u64(sb->items + sb->length + length, magnitude);
+    sb->length += length;
+}
+
+void dawn_sb_append_hex(DawnStringBuilder *sb, uint64_t value, size_t min_digits) {
+    static const char hex_digits[16] = "0123456789abcdef";
+    size_t digits = (67 - dawn__clz64(value | 1)) / 4;
+    if (digits < min_digits) digits = min_digits;
+    DAWN_DA_RESERVE(sb, digits);
+    char *end = sb->items + sb->length + digits;
+    for (size_t i = 0; i < digits; i++) {
+        *--end = hex_digits[value & 0xF];
+        value >>= 4;
+    }
+    sb->length += digits;
+}
+
+// Shortest round-trip conversion uses Schubfach (R. Giulietti, "The
+// Schubfach way to render doubles", 2020), after the implementation in
+// A. Bolz's Drachennest.
+
+typedef struct {
+    uint64_t hi;
+    uint64_t lo;
+} Dawn__U128;
+
+#define DAWN__POW10_MIN_EXPONENT (-292)
+
+// floor(10^k / 2^(floor(log2(10^k)) - 127)) + 1 for k in [-292, 326].
+static const Dawn__U128 dawn__pow10_u128[619] = {
+    {0xff77b1fcbebcdc4full, 0x25e8e89c13bb0f7bull}, {0x9faacf3df73609b1ull, 0x77b191618c54e9adull},
+    {0xc795830d75038c1dull, 0xd59df5b9ef6a2418ull}, {0xf97ae3d0d2446f25ull, 0x4b0573286b44ad1eull},
+    {0x9becce62836ac577ull, 0x4ee367f9430aec33ull}, {0xc2e801fb244576d5ull, 0x229c41f793cda740ull},
+    {0xf3a20279ed56d48aull, 0x6b43527578c11110ull}, {0x9845418c345644d6ull, 0x830a13896b78aaaaull},
+    {0xbe5691ef416bd60cull, 0x23cc986bc656d554ull}, {0xedec366b11c6cb8full, 0x2cbfbe86b7ec8aa9ull},
+    {0x94b3a202eb1c3f39ull, 0x7bf7d71432f3d6aaull}, {0xb9e08a83a5e34f07ull, 0xdaf5ccd93fb0cc54ull},
+    {0xe858ad248f5c22c9ull, 0xd1b3400f8f9cff69ull}, {0x91376c36d99995beull, 0x23100809b9c21fa2ull},
+    {0xb58547448ffffb2dull, 0xabd40a0c2832a78bull}, {0xe2e69915b3fff9f9ull, 0x16c90c8f323f516dull},
+    {0x8dd01fad907ffc3bull, 0xae3da7d97f6792e4ull}, {0xb1442798f49ffb4aull, 0x99cd11cfdf41779dull},
+    {0xdd95317f31c7fa1dull, 0x40405643d711d584ull}, {0x8a7d3eef7f1cfc52ull, 0x482835ea666b2573ull},
+    {0xad1c8eab5ee43b66ull, 0xda3243650005eed0ull}, {0xd863b256369d4a40ull, 0x90bed43e40076a83ull},
+    {0x873e4f75e2224e68ull, 0x5a7744a6e804a292ull}, {0xa90de3535aaae202ull, 0x711515d0a205cb37ull},
+    {0xd3515c2831559a83ull, 0x0d5a5b44ca873e04ull}, {0x8412d9991ed58091ull, 0xe858790afe9486c3ull},
+    {0xa5178fff668ae0b6ull, 0x626e974dbe39a873ull}, {0xce5d73ff402d98e3ull, 0xfb0a3d212dc81290ull},
+    {0x80fa687f881c7f8eull, 0x7ce66634bc9d0b9aull}, {0xa139029f6a239f72ull, 0x1c1fffc1ebc44e81ull},
+    {0xc987434744ac874eull, 0xa327ffb266b56221ull}, {0xfbe9141915d7a922ull, 0x4bf1ff9f0062baa9ull},
+    {0x9d71ac8fada6c9b5ull, 0x6f773fc3603db4aaull}, {0xc4ce17b399107c22ull, 0xcb550fb4384d21d4ull},
+    {0xf6019da07f549b2bull, 0x7e2a53a146606a49ull}, {0x99c102844f94e0fbull, 0x2eda7444cbfc426eull},
+    {0xc0314325637a1939ull, 0xfa911155fefb5309ull}, {0xf03d93eebc589f88ull, 0x793555ab7eba27cbull},
+    {0x96267c7535b763b5ull, 0x4bc1558b2f3458dfull}, {0xbbb01b9283253ca2ull, 0x9eb1aaedfb016f17ull},
+    {0xea9c227723ee8bcbull, 0x465e15a979c1caddull}, {0x92a1958a7675175full, 0x0bfacd89ec191ecaull},
+    {0xb749faed14125d36ull, 0xcef980ec671f667cull}, {0xe51c79a85916f484ull, 0x82b7e12780e7401bull},
+    {0x8f31cc0937ae58d2ull, 0xd1b2ecb8b0908811ull}, {0xb2fe3f0b8599ef07ull, 0x861fa7e6dcb4aa16ull},
+    {0xdfbdcece67006ac9ull, 0x67a791e093e1d49bull}, {0x8bd6a141006042bdull, 0xe0c8bb2c5c6d24e1ull},
+    {0xaecc49914078536dull, 0x58fae9f773886e19ull}, {0xda7f5bf590966848ull, 0xaf39a475506a899full},
+    {0x888f99797a5e012dull, 0x6d8406c952429604ull}, {0xaab37fd7d8f58178ull, 0xc8e5087ba6d33b84ull},
+    {0xd5605fcdcf32e1d6ull, 0xfb1e4a9a90880a65ull}, {0x855c3be0a17fcd26ull, 0x5cf2eea09a550680ull},
+    {0xa6b34ad8c9dfc06full, 0xf42faa48c0ea481full}, {0xd0601d8efc57b08bull, 0xf13b94daf124da27ull},
+    {0x823c12795db6ce57ull, 0x76c53d08d6b70859ull}, {0xa2cb1717b52481edull, 0x54768c4b0c64ca6full},
+    {0xcb7ddcdda26da268ull, 0xa9942f5dcf7dfd0aull}, {0xfe5d54150b090b02ull, 0xd3f93b35435d7c4dull},
+    {0x9efa548d26e5a6e1ull, 0xc47bc5014a1a6db0ull}, {0xc6b8e9b0709f109aull, 0x359ab6419ca1091cull},
+    {0xf867241c8cc6d4c0ull, 0xc30163d203c94b63ull}, {0x9b407691d7fc44f8ull, 0x79e0de63425dcf1eull},
+    {0xc21094364dfb5636ull, 0x985915fc12f542e5ull}, {0xf294b943e17a2bc4ull, 0x3e6f5b7b17b2939eull},
+    {0x979cf3ca6cec5b5aull, 0xa705992ceecf9c43ull}, {0xbd8430bd08277231ull, 0x50c6ff782a838354ull},
+    {0xece53cec4a314ebdull, 0xa4f8bf5635246429ull}, {0x940f4613ae5ed136ull, 0x871b7795e136be9aull},
+    {0xb913179899f68584ull, 0x28e2557b59846e40ull}, {0xe757dd7ec07426e5ull, 0x331aeada2fe589d0ull},
+    {0x9096ea6f3848984full, 0x3ff0d2c85def7622ull}, {0xb4bca50b065abe63ull, 0x0fed077a756b53aaull},
+    {0xe1ebce4dc7f16dfbull, 0xd3e8495912c62895ull}, {0x8d3360f09cf6e4bdull, 0x64712dd7abbbd95dull},
+    {0xb080392cc4349decull, 0xbd8d794d96aacfb4ull}, {0xdca04777f541c567ull, 0xecf0d7a0fc5583a1ull},
+    {0x89e42caaf9491b60ull, 0xf41686c49db57245ull}, {0xac5d37d5b79b6239ull, 0x311c2875c522ced6ull},
+    {0xd77485cb25823ac7ull, 0x7d633293366b828cull}, {0x86a8d39ef77164bcull, 0xae5dff9c02033198ull},
+    {0xa8530886b54dbdebull, 0xd9f57f830283fdfdull}, {0xd267caa862a12d66ull, 0xd072df63c324fd7cull},
+    {0x8380dea93da4bc60ull, 0x4247cb9e59f71e6eull}, {0xa46116538d0deb78ull, 0x52d9be85f074e609ull},
+    {0xcd795be870516656ull, 0x67902e276c921f8cull}, {0x806bd9714632dff6ull, 0x00ba1cd8a3db53b7ull},
+    {0xa086cfcd97bf97f3ull, 0x80e8a40eccd228a5ull}, {0xc8a883c0fdaf7df0ull, 0x6122cd128006b2ceull},
+    {0xfad2a4b13d1b5d6cull, 0x796b805720085f82ull}, {0x9cc3a6eec6311a63ull, 0xcbe3303674053bb1ull},
+    {0xc3f490aa77bd60fcull, 0xbedbfc4411068a9dull}, {0xf4f1b4d515acb93bull, 0xee92fb5515482d45ull},
+    {0x991711052d8bf3c5ull, 0x751bdd152d4d1c4bull}, {0xbf5cd54678eef0b6ull, 0xd262d45a78a0635eull},
+    {0xef340a98172aace4ull, 0x86fb897116c87c35ull}, {0x9580869f0e7aac0eull, 0xd45d35e6ae3d4da1ull},
+    {0xbae0a846d2195712ull, 0x8974836059cca10aull}, {0xe998d258869facd7ull, 0x2bd1a438703fc94cull},
+    {0x91ff83775423cc06ull, 0x7b6306a34627ddd0ull}, {0xb67f6455292cbf08ull, 0x1a3bc84c17b1d543ull},
+    {0xe41f3d6a7377eecaull, 0x20caba5f1d9e4a94ull}, {0x8e938662882af53eull, 0x547eb47b7282ee9dull},
+    {0xb23867fb2a35b28dull, 0xe99e619a4f23aa44ull}, {0xdec681f9f4c31f31ull, 0x6405fa00e2ec94d5ull},
+    {0x8b3c113c38f9f37eull, 0xde83bc408dd3dd05ull}, {0xae0b158b4738705eull, 0x9624ab50b148d446ull},
+    {0xd98ddaee19068c76ull, 0x3badd624dd9b0958ull}, {0x87f8a8d4cfa417c9ull, 0xe54ca5d70a80e5d7ull},
+    {0xa9f6d30a038d1dbcull, 0x5e9fcf4ccd211f4dull}, {0xd47487cc8470652bull, 0x7647c32000696720ull},
+    {0x84c8d4dfd2c63f3bull, 0x29ecd9f40041e074ull}, {0xa5fb0a17c777cf09ull, 0xf468107100525891ull},
+    {0xcf79cc9db955c2ccull, 0x7182148d4066eeb5ull}, {0x81ac1fe293d599bfull, 0xc6f14cd848405531ull},
+    {0xa21727db38cb002full, 0xb8ada00e5a506a7dull}, {0xca9cf1d206fdc03bull, 0xa6d90811f0e4851dull},
+    {0xfd442e4688bd304aull, 0x908f4a166d1da664ull}, {0x9e4a9cec15763e2eull, 0x9a598e4e043287ffull},
+    {0xc5dd44271ad3cdbaull, 0x40eff1e1853f29feull}, {0xf7549530e188c128ull, 0xd12bee59e68ef47dull},
+    {0x9a94dd3e8cf578b9ull, 0x82bb74f8301958cfull}, {0xc13a148e3032d6e7ull, 0xe36a52363c1faf02ull},
+    {0xf18899b1bc3f8ca1ull, 0xdc44e6c3cb279ac2ull}, {0x96f5600f15a7b7e5ull, 0x29ab103a5ef8c0baull},
+    {0xbcb2b812db11a5deull, 0x7415d448f6b6f0e8ull}, {0xebdf661791d60f56ull, 0x111b495b3464ad22ull},
+    {0x936b9fcebb25c995ull, 0xcab10dd900beec35ull}, {0xb84687c269ef3bfbull, 0x3d5d514f40eea743ull},
+    {0xe65829b3046b0afaull, 0x0cb4a5a3112a5113ull}, {0x8ff71a0fe2c2e6dcull, 0x47f0e785eaba72acull},
+    {0xb3f4e093db73a093ull, 0x59ed216765690f57ull}, {0xe0f218b8d25088b8ull, 0x306869c13ec3532dull},
+    {0x8c974f7383725573ull, 0x1e414218c73a13fcull}, {0xafbd2350644eeacfull, 0xe5d1929ef90898fbull},
+    {0xdbac6c247d62a583ull, 0xdf45f746b74abf3aull}, {0x894bc396ce5da772ull, 0x6b8bba8c328eb784ull},
+    {0xab9eb47c81f5114full, 0x066ea92f3f326565ull}, {0xd686619ba27255a2ull, 0xc80a537b0efefebeull},
+    {0x8613fd0145877585ull, 0xbd06742ce95f5f37ull}, {0xa798fc4196e952e7ull, 0x2c48113823b73705ull},
+    {0xd17f3b51fca3a7a0ull, 0xf75a15862ca504c6ull}, {0x82ef85133de648c4ull, 0x9a984d73dbe722fcull},
+    {0xa3ab66580d5fdaf5ull, 0xc13e60d0d2e0ebbbull}, {0xcc963fee10b7d1b3ull, 0x318df905079926a9ull},
+    {0xffbbcfe994e5c61full, 0xfdf17746497f7053ull}, {0x9fd561f1fd0f9bd3ull, 0xfeb6ea8bedefa634ull},
+    {0xc7caba6e7c5382c8ull, 0xfe64a52ee96b8fc1ull}, {0xf9bd690a1b68637bull, 0x3dfdce7aa3c673b1ull},
+    {0x9c1661a651213e2dull, 0x06bea10ca65c084full}, {0xc31bfa0fe5698db8ull, 0x486e494fcff30a63ull},
+    {0xf3e2f893dec3f126ull, 0x5a89dba3c3efccfbull}, {0x986ddb5c6b3a76b7ull, 0xf89629465a75e01dull},
+    {0xbe89523386091465ull, 0xf6bbb397f1135824ull}, {0xee2ba6c0678b597full, 0x746aa07ded582e2dull},
+    {0x94db483840b717efull, 0xa8c2a44eb4571cddull}, {0xba121a4650e4ddebull, 0x92f34d62616ce414ull},
+    {0xe896a0d7e51e1566ull, 0x77b020baf9c81d18ull}, {0x915e2486ef32cd60ull, 0x0ace1474dc1d122full},
+    {0xb5b5ada8aaff80b8ull, 0x0d819992132456bbull}, {0xe3231912d5bf60e6ull, 0x10e1fff697ed6c6aull},
+    {0x8df5efabc5979c8full, 0xca8d3ffa1ef463c2ull}, {0xb1736b96b6fd83b3ull, 0xbd308ff8a6b17cb3ull},
+    {0xddd0467c64bce4a0ull, 0xac7cb3f6d05ddbdfull}, {0x8aa22c0dbef60ee4ull, 0x6bcdf07a423aa96cull},
+    {0xad4ab7112eb3929dull, 0x86c16c98d2c953c7ull}, {0xd89d64d57a607744ull, 0xe871c7bf077ba8b8ull},
+    {0x87625f056c7c4a8bull, 0x11471cd764ad4973ull}, {0xa93af6c6c79b5d2dull, 0xd598e40d3dd89bd0ull},
+    {0xd389b47879823479ull, 0x4aff1d108d4ec2c4ull}, {0x843610cb4bf160cbull, 0xcedf722a585139bbull},
+    {0xa54394fe1eedb8feull, 0xc2974eb4ee658829ull}, {0xce947a3da6a9273eull, 0x733d226229feea33ull},
+    {0x811ccc668829b887ull, 0x0806357d5a3f5260ull}, {0xa163ff802a3426a8ull, 0xca07c2dcb0cf26f8ull},
+    {0xc9bcff6034c13052ull, 0xfc89b393dd02f0b6ull}, {0xfc2c3f3841f17c67ull, 0xbbac2078d443ace3ull},
+    {0x9d9ba7832936edc0ull, 0xd54b944b84aa4c0eull}, {0xc5029163f384a931ull, 0x0a9e795e65d4df12ull},
+    {0xf64335bcf065d37dull, 0x4d4617b5ff4a16d6ull}, {0x99ea0196163fa42eull, 0x504bced1bf8e4e46ull},
+    {0xc06481fb9bcf8d39ull, 0xe45ec2862f71e1d7ull}, {0xf07da27a82c37088ull, 0x5d767327bb4e5a4dull},
+    {0x964e858c91ba2655ull, 0x3a6a07f8d510f870ull}, {0xbbe226efb628afeaull, 0x890489f70a55368cull},
+    {0xeadab0aba3b2dbe5ull, 0x2b45ac74ccea842full}, {0x92c8ae6b464fc96full, 0x3b0b8bc90012929eull},
+    {0xb77ada0617e3bbcbull, 0x09ce6ebb40173745ull}, {0xe55990879ddcaabdull, 0xcc420a6a101d0516ull},
+    {0x8f57fa54c2a9eab6ull, 0x9fa946824a12232eull}, {0xb32df8e9f3546564ull, 0x47939822dc96abfaull},
+    {0xdff9772470297ebdull, 0x59787e2b93bc56f8ull}, {0x8bfbea76c619ef36ull, 0x57eb4edb3c55b65bull},
+    {0xaefae51477a06b03ull, 0xede622920b6b23f2ull}, {0xdab99e59958885c4ull, 0xe95fab368e45eceeull},
+    {0x88b402f7fd75539bull, 0x11dbcb0218ebb415ull}, {0xaae103b5fcd2a881ull, 0xd652bdc29f26a11aull},
+    {0xd59944a37c0752a2ull, 0x4be76d3346f04960ull}, {0x857fcae62d8493a5ull, 0x6f70a4400c562ddcull},
+    {0xa6dfbd9fb8e5b88eull, 0xcb4ccd500f6bb953ull}, {0xd097ad07a71f26b2ull, 0x7e2000a41346a7a8ull},
+    {0x825ecc24c873782full, 0x8ed400668c0c28c9ull}, {0xa2f67f2dfa90563bull, 0x728900802f0f32fbull},
+    {0xcbb41ef979346bcaull, 0x4f2b40a03ad2ffbaull}, {0xfea126b7d78186bcull, 0xe2f610c84987bfa9ull},
+    {0x9f24b832e6b0f436ull, 0x0dd9ca7d2df4d7caull}, {0xc6ede63fa05d3143ull, 0x91503d1c79720dbcull},
+    {0xf8a95fcf88747d94ull, 0x75a44c6397ce912bull}, {0x9b69dbe1b548ce7cull, 0xc986afbe3ee11abbull},
+    {0xc24452da229b021bull, 0xfbe85badce996169ull}, {0xf2d56790ab41c2a2ull, 0xfae27299423fb9c4ull},
+    {0x97c560ba6b0919a5ull, 0xdccd879fc967d41bull}, {0xbdb6b8e905cb600full, 0x5400e987bbc1c921ull},
+    {0xed246723473e3813ull, 0x290123e9aab23b69ull}, {0x9436c0760c86e30bull, 0xf9a0b6720aaf6522ull},
+    {0xb94470938fa89bceull, 0xf808e40e8d5b3e6aull}, {0xe7958cb87392c2c2ull, 0xb60b1d1230b20e05ull},
+    {0x90bd77f3483bb9b9ull, 0xb1c6f22b5e6f48c3ull}, {0xb4ecd5f01a4aa828ull, 0x1e38aeb6360b1af4ull},
+    {0xe2280b6c20dd5232ull, 0x25c6da63c38de1b1ull}, {0x8d590723948a535full, 0x579c487e5a38ad0full},
+    {0xb0af48ec79ace837ull, 0x2d835a9df0c6d852ull}, {0xdcdb1b2798182244ull, 0xf8e431456cf88e66ull},
+    {0x8a08f0f8bf0f156bull, 0x1b8e9ecb641b5900ull}, {0xac8b2d36eed2dac5ull, 0xe272467e3d222f40ull},
+    {0xd7adf884aa879177ull, 0x5b0ed81dcc6abb10ull}, {0x86ccbb52ea94baeaull, 0x98e947129fc2b4eaull},
+    {0xa87fea27a539e9a5ull, 0x3f2398d747b36225ull}, {0xd29fe4b18e88640eull, 0x8eec7f0d19a03aaeull},
+    {0x83a3eeeef9153e89ull, 0x1953cf68300424adull}, {0xa48ceaaab75a8e2bull, 0x5fa8c3423c052dd8ull},
+    {0xcdb02555653131b6ull, 0x3792f412cb06794eull}, {0x808e17555f3ebf11ull, 0xe2bbd88bbee40bd1ull},
+    {0xa0b19d2ab70e6ed6ull, 0x5b6aceaeae9d0ec5ull}, {0xc8de047564d20a8bull, 0xf245825a5a445276ull},
+    {0xfb158592be068d2eull, 0xeed6e2f0f0d56713ull}, {0x9ced737bb6c4183dull, 0x55464dd69685606cull},
+    {0xc428d05aa4751e4cull, 0xaa97e14c3c26b887ull}, {0xf53304714d9265dfull, 0xd53dd99f4b3066a9ull},
+    {0x993fe2c6d07b7fabull, 0xe546a8038efe402aull}, {0xbf8fdb78849a5f96ull, 0xde98520472bdd034ull},
+    {0xef73d256a5c0f77cull, 0x963e66858f6d4441ull}, {0x95a8637627989aadull, 0xdde7001379a44aa9ull},
+    {0xbb127c53b17ec159ull, 0x5560c018580d5d53ull}, {0xe9d71b689dde71afull, 0xaab8f01e6e10b4a7ull},
+    {0x9226712162ab070dull, 0xcab3961304ca70e9ull}, {0xb6b00d69bb55c8d1ull, 0x3d607b97c5fd0d23ull},
+    {0xe45c10c42a2b3b05ull, 0x8cb89a7db77c506bull}, {0x8eb98a7a9a5b04e3ull, 0x77f3608e92adb243ull},
+    {0xb267ed1940f1c61cull, 0x55f038b237591ed4ull}, {0xdf01e85f912e37a3ull, 0x6b6c46dec52f6689ull},
+    {0x8b61313bbabce2c6ull, 0x2323ac4b3b3da016ull}, {0xae397d8aa96c1b77ull, 0xabec975e0a0d081bull},
+    {0xd9c7dced53c72255ull, 0x96e7bd358c904a22ull}, {0x881cea14545c7575ull, 0x7e50d64177da2e55ull},
+    {0xaa242499697392d2ull, 0xdde50bd1d5d0b9eaull}, {0xd4ad2dbfc3d07787ull, 0x955e4ec64b44e865ull},
+    {0x84ec3c97da624ab4ull, 0xbd5af13bef0b113full}, {0xa6274bbdd0fadd61ull, 0xecb1ad8aeacdd58full},
+    {0xcfb11ead453994baull, 0x67de18eda5814af3ull}, {0x81ceb32c4b43fcf4ull, 0x80eacf948770ced8ull},
+    {0xa2425ff75e14fc31ull, 0xa1258379a94d028eull}, {0xcad2f7f5359a3b3eull, 0x096ee45813a04331ull},
+    {0xfd87b5f28300ca0dull, 0x8bca9d6e188853fdull}, {0x9e74d1b791e07e48ull, 0x775ea264cf55347eull},
+    {0xc612062576589ddaull, 0x95364afe032a819eull}, {0xf79687aed3eec551ull, 0x3a83ddbd83f52205ull},
+    {0x9abe14cd44753b52ull, 0xc4926a9672793543ull}, {0xc16d9a0095928a27ull, 0x75b7053c0f178294ull},
+    {0xf1c90080baf72cb1ull, 0x5324c68b12dd6339ull}, {0x971da05074da7beeull, 0xd3f6fc16ebca5e04ull},
+    {0xbce5086492111aeaull, 0x88f4bb1ca6bcf585ull}, {0xec1e4a7db69561a5ull, 0x2b31e9e3d06c32e6ull},
+    {0x9392ee8e921d5d07ull, 0x3aff322e62439fd0ull}, {0xb877aa3236a4b449ull, 0x09befeb9fad487c3ull},
+    {0xe69594bec44de15bull, 0x4c2ebe687989a9b4ull}, {0x901d7cf73ab0acd9ull, 0x0f9d37014bf60a11ull},
+    {0xb424dc35095cd80full, 0x538484c19ef38c95ull}, {0xe12e13424bb40e13ull, 0x2865a5f206b06fbaull},
+    {0x8cbccc096f5088cbull, 0xf93f87b7442e45d4ull}, {0xafebff0bcb24aafeull, 0xf78f69a51539d749ull},
+    {0xdbe6fecebdedd5beull, 0xb573440e5a884d1cull}, {0x89705f4136b4a597ull, 0x31680a88f8953031ull},
+    {0xabcc77118461cefcull, 0xfdc20d2b36ba7c3eull}, {0xd6bf94d5e57a42bcull, 0x3d32907604691b4dull},
+    {0x8637bd05af6c69b5ull, 0xa63f9a49c2c1b110ull}, {0xa7c5ac471b478423ull, 0x0fcf80dc33721d54ull},
+    {0xd1b71758e219652bull, 0xd3c36113404ea4a9ull}, {0x83126e978d4fdf3bull, 0x645a1cac083126eaull},
+    {0xa3d70a3d70a3d70aull, 0x3d70a3d70a3d70a4ull}, {0xccccccccccccccccull, 0xcccccccccccccccdull},
+    {0x8000000000000000ull, 0x0000000000000001ull}, {0xa000000000000000ull, 0x0000000000000001ull},
+    {0xc800000000000000ull, 0x0000000000000001ull}, {0xfa00000000000000ull, 0x0000000000000001ull},
+    {0x9c40000000000000ull, 0x0000000000000001ull}, {0xc350000000000000ull, 0x0000000000000001ull},
+    {0xf424000000000000ull, 0x0000000000000001ull}, {0x9896800000000000ull, 0x0000000000000001ull},
+    {0xbebc200000000000ull, 0x0000000000000001ull}, {0xee6b280000000000ull, 0x0000000000000001ull},
+    {0x9502f90000000000ull, 0x0000000000000001ull}, {0xba43b74000000000ull, 0x0000000000000001ull},
+    {0xe8d4a51000000000ull, 0x0000000000000001ull}, {0x9184e72a00000000ull, 0x0000000000000001ull},
+    {0xb5e620f480000000ull, 0x0000000000000001ull}, {0xe35fa931a0000000ull, 0x0000000000000001ull},
+    {0x8e1bc9bf04000000ull, 0x0000000000000001ull}, {0xb1a2bc2ec5000000ull, 0x0000000000000001ull},
+    {0xde0b6b3a76400000ull, 0x0000000000000001ull}, {0x8ac7230489e80000ull, 0x0000000000000001ull},
+    {0xad78ebc5ac620000ull, 0x0000000000000001ull}, {0xd8d726b7177a8000ull, 0x0000000000000001ull},
+    {0x878678326eac9000ull, 0x0000000000000001ull}, {0xa968163f0a57b400ull, 0x0000000000000001ull},
+    {0xd3c21bcecceda100ull, 0x0000000000000001ull}, {0x84595161401484a0ull, 0x0000000000000001ull},
+    {0xa56fa5b99019a5c8ull, 0x0000000000000001ull}, {0xcecb8f27f4200f3aull, 0x0000000000000001ull},
+    {0x813f3978f8940984ull, 0x4000000000000001ull}, {0xa18f07d736b90be5ull, 0x5000000000000001ull},
+    {0xc9f2c9cd04674edeull, 0xa400000000000001ull}, {0xfc6f7c4045812296ull, 0x4d00000000000001ull},
+    {0x9dc5ada82b70b59dull, 0xf020000000000001ull}, {0xc5371912364ce305ull, 0x6c28000000000001ull},
+    {0xf684df56c3e01bc6ull, 0xc732000000000001ull}, {0x9a130b963a6c115cull, 0x3c7f400000000001ull},
+    {0xc097ce7bc90715b3ull, 0x4b9f100000000001ull}, {0xf0bdc21abb48db20ull, 0x1e86d40000000001ull},
+    {0x96769950b50d88f4ull, 0x1314448000000001ull}, {0xbc143fa4e250eb31ull, 0x17d955a000000001ull},
+    {0xeb194f8e1ae525fdull, 0x5dcfab0800000001ull}, {0x92efd1b8d0cf37beull, 0x5aa1cae500000001ull},
+    {0xb7abc627050305adull, 0xf14a3d9e40000001ull}, {0xe596b7b0c643c719ull, 0x6d9ccd05d0000001ull},
+    {0x8f7e32ce7bea5c6full, 0xe4820023a2000001ull}, {0xb35dbf821ae4f38bull, 0xdda2802c8a800001ull},
+    {0xe0352f62a19e306eull, 0xd50b2037ad200001ull}, {0x8c213d9da502de45ull, 0x4526f422cc340001ull},
+    {0xaf298d050e4395d6ull, 0x9670b12b7f410001ull}, {0xdaf3f04651d47b4cull, 0x3c0cdd765f114001ull},
+    {0x88d8762bf324cd0full, 0xa5880a69fb6ac801ull}, {0xab0e93b6efee0053ull, 0x8eea0d047a457a01ull},
+    {0xd5d238a4abe98068ull, 0x72a4904598d6d881ull}, {0x85a36366eb71f041ull, 0x47a6da2b7f864751ull},
+    {0xa70c3c40a64e6c51ull, 0x999090b65f67d925ull}, {0xd0cf4b50cfe20765ull, 0xfff4b4e3f741cf6eull},
+    {0x82818f1281ed449full, 0xbff8f10e7a8921a5ull}, {0xa321f2d7226895c7ull, 0xaff72d52192b6a0eull},
+    {0xcbea6f8ceb02bb39ull, 0x9bf4f8a69f764491ull}, {0xfee50b7025c36a08ull, 0x02f236d04753d5b5ull},
+    {0x9f4f2726179a2245ull, 0x01d762422c946591ull}, {0xc722f0ef9d80aad6ull, 0x424d3ad2b7b97ef6ull},
+    {0xf8ebad2b84e0d58bull, 0xd2e0898765a7deb3ull}, {0x9b934c3b330c8577ull, 0x63cc55f49f88eb30ull},
+    {0xc2781f49ffcfa6d5ull, 0x3cbf6b71c76b25fcull}, {0xf316271c7fc3908aull, 0x8bef464e3945ef7bull},
+    {0x97edd871cfda3a56ull, 0x97758bf0e3cbb5adull}, {0xbde94e8e43d0c8ecull, 0x3d52eeed1cbea318ull},
+    {0xed63a231d4c4fb27ull, 0x4ca7aaa863ee4bdeull}, {0x945e455f24fb1cf8ull, 0x8fe8caa93e74ef6bull},
+    {0xb975d6b6ee39e436ull, 0xb3e2fd538e122b45ull}, {0xe7d34c64a9c85d44ull, 0x60dbbca87196b617ull},
+    {0x90e40fbeea1d3a4aull, 0xbc8955e946fe31ceull}, {0xb51d13aea4a488ddull, 0x6babab6398bdbe42ull},
+    {0xe264589a4dcdab14ull, 0xc696963c7eed2dd2ull}, {0x8d7eb76070a08aecull, 0xfc1e1de5cf543ca3ull},
+    {0xb0de65388cc8ada8ull, 0x3b25a55f43294bccull}, {0xdd15fe86affad912ull, 0x49ef0eb713f39ebfull},
+    {0x8a2dbf142dfcc7abull, 0x6e3569326c784338ull}, {0xacb92ed9397bf996ull, 0x49c2c37f07965405ull},
+    {0xd7e77a8f87daf7fbull, 0xdc33745ec97be907ull}, {0x86f0ac99b4e8dafdull, 0x69a028bb3ded71a4ull},
+    {0xa8acd7c0222311bcull, 0xc40832ea0d68ce0dull}, {0xd2d80db02aabd62bull, 0xf50a3fa490c30191ull},
+    {0x83c7088e1aab65dbull, 0x792667c6da79e0fbull}, {0xa4b8cab1a1563f52ull, 0x577001b891185939ull},
+    {0xcde6fd5e09abcf26ull, 0xed4c0226b55e6f87ull}, {0x80b05e5ac60b6178ull, 0x544f8158315b05b5ull},
+    {0xa0dc75f1778e39d6ull, 0x696361ae3db1c722ull}, {0xc913936dd571c84cull, 0x03bc3a19cd1e38eaull},
+    {0xfb5878494ace3a5full, 0x04ab48a04065c724ull}, {0x9d174b2dcec0e47bull, 0x62eb0d64283f9c77ull},
+    {0xc45d1df942711d9aull, 0x3ba5d0bd324f8395ull}, {0xf5746577930d6500ull, 0xca8f44ec7ee3647aull},
+    {0x9968bf6abbe85f20ull, 0x7e998b13cf4e1eccull}, {0xbfc2ef456ae276e8ull, 0x9e3fedd8c321a67full},
+    {0xefb3ab16c59b14a2ull, 0xc5cfe94ef3ea101full}, {0x95d04aee3b80ece5ull, 0xbba1f1d158724a13ull},
+    {0xbb445da9ca61281full, 0x2a8a6e45ae8edc98ull}, {0xea1575143cf97226ull, 0xf52d09d71a3293beull},
+    {0x924d692ca61be758ull, 0x593c2626705f9c57ull}, {0xb6e0c377cfa2e12eull, 0x6f8b2fb00c77836dull},
+    {0xe498f455c38b997aull, 0x0b6dfb9c0f956448ull}, {0x8edf98b59a373fecull, 0x4724bd4189bd5eadull},
+    {0xb2977ee300c50fe7ull, 0x58edec91ec2cb658ull}, {0xdf3d5e9bc0f653e1ull, 0x2f2967b66737e3eeull},
+    {0x8b865b215899f46cull, 0xbd79e0d20082ee75ull}, {0xae67f1e9aec07187ull, 0xecd8590680a3aa12ull},
+    {0xda01ee641a708de9ull, 0xe80e6f4820cc9496ull}, {0x884134fe908658b2ull, 0x3109058d147fdcdeull},
+    {0xaa51823e34a7eedeull, 0xbd4b46f0599fd416ull}, {0xd4e5e2cdc1d1ea96ull, 0x6c9e18ac7007c91bull},
+    {0x850fadc09923329eull, 0x03e2cf6bc604ddb1ull}, {0xa6539930bf6bff45ull, 0x84db8346b786151dull},
+    {0xcfe87f7cef46ff16ull, 0xe612641865679a64ull}, {0x81f14fae158c5f6eull, 0x4fcb7e8f3f60c07full},
+    {0xa26da3999aef7749ull, 0xe3be5e330f38f09eull}, {0xcb090c8001ab551cull, 0x5cadf5bfd3072cc6ull},
+    {0xfdcb4fa002162a63ull, 0x73d9732fc7c8f7f7ull}, {0x9e9f11c4014dda7eull, 0x2867e7fddcdd9afbull},
+    {0xc646d63501a1511dull, 0xb281e1fd541501b9ull}, {0xf7d88bc24209a565ull, 0x1f225a7ca91a4227ull},
+    {0x9ae757596946075full, 0x3375788de9b06959ull}, {0xc1a12d2fc3978937ull, 0x0052d6b1641c83afull},
+    {0xf209787bb47d6b84ull, 0xc0678c5dbd23a49bull}, {0x9745eb4d50ce6332ull, 0xf840b7ba963646e1ull},
+    {0xbd176620a501fbffull, 0xb650e5a93bc3d899ull}, {0xec5d3fa8ce427affull, 0xa3e51f138ab4cebfull},
+    {0x93ba47c980e98cdfull, 0xc66f336c36b10138ull}, {0xb8a8d9bbe123f017ull, 0xb80b0047445d4185ull},
+    {0xe6d3102ad96cec1dull, 0xa60dc059157491e6ull}, {0x9043ea1ac7e41392ull, 0x87c89837ad68db30ull},
+    {0xb454e4a179dd1877ull, 0x29babe4598c311fcull}, {0xe16a1dc9d8545e94ull, 0xf4296dd6fef3d67bull},
+    {0x8ce2529e2734bb1dull, 0x1899e4a65f58660dull}, {0xb01ae745b101e9e4ull, 0x5ec05dcff72e7f90ull},
+    {0xdc21a1171d42645dull, 0x76707543f4fa1f74ull}, {0x899504ae72497ebaull, 0x6a06494a791c53a9ull},
+    {0xabfa45da0edbde69ull, 0x0487db9d17636893ull}, {0xd6f8d7509292d603ull, 0x45a9d2845d3c42b7ull},
+    {0x865b86925b9bc5c2ull, 0x0b8a2392ba45a9b3ull}, {0xa7f26836f282b732ull, 0x8e6cac7768d7141full},
+    {0xd1ef0244af2364ffull, 0x3207d795430cd927ull}, {0x8335616aed761f1full, 0x7f44e6bd49e807b9ull},
+    {0xa402b9c5a8d3a6e7ull, 0x5f16206c9c6209a7ull}, {0xcd036837130890a1ull, 0x36dba887c37a8c10ull},
+    {0x802221226be55a64ull, 0xc2494954da2c978aull}, {0xa02aa96b06deb0fdull, 0xf2db9baa10b7bd6dull},
+    {0xc83553c5c8965d3dull, 0x6f92829494e5acc8ull}, {0xfa42a8b73abbf48cull, 0xcb772339ba1f17faull},
+    {0x9c69a97284b578d7ull, 0xff2a760414536efcull}, {0xc38413cf25e2d70dull, 0xfef5138519684abbull},
+    {0xf46518c2ef5b8cd1ull, 0x7eb258665fc25d6aull}, {0x98bf2f79d5993802ull, 0xef2f773ffbd97a62ull},
+    {0xbeeefb584aff8603ull, 0xaafb550ffacfd8fbull}, {0xeeaaba2e5dbf6784ull, 0x95ba2a53f983cf39ull},
+    {0x952ab45cfa97a0b2ull, 0xdd945a747bf26184ull}, {0xba756174393d88dfull, 0x94f971119aeef9e5ull},
+    {0xe912b9d1478ceb17ull, 0x7a37cd5601aab85eull}, {0x91abb422ccb812eeull, 0xac62e055c10ab33bull},
+    {0xb616a12b7fe617aaull, 0x577b986b314d600aull}, {0xe39c49765fdf9d94ull, 0xed5a7e85fda0b80cull},
+    {0x8e41ade9fbebc27dull, 0x14588f13be847308ull}, {0xb1d219647ae6b31cull, 0x596eb2d8ae258fc9ull},
+    {0xde469fbd99a05fe3ull, 0x6fca5f8ed9aef3bcull}, {0x8aec23d680043beeull, 0x25de7bb9480d5855ull},
+    {0xada72ccc20054ae9ull, 0xaf561aa79a10ae6bull}, {0xd910f7ff28069da4ull, 0x1b2ba1518094da05ull},
+    {0x87aa9aff79042286ull, 0x90fb44d2f05d0843ull}, {0xa99541bf57452b28ull, 0x353a1607ac744a54ull},
+    {0xd3fa922f2d1675f2ull, 0x42889b8997915ce9ull}, {0x847c9b5d7c2e09b7ull, 0x69956135febada12ull},
+    {0xa59bc234db398c25ull, 0x43fab9837e699096ull}, {0xcf02b2c21207ef2eull, 0x94f967e45e03f4bcull},
+    {0x8161afb94b44f57dull, 0x1d1be0eebac278f6ull}, {0xa1ba1ba79e1632dcull, 0x6462d92a69731733ull},
+    {0xca28a291859bbf93ull, 0x7d7b8f7503cfdcffull}, {0xfcb2cb35e702af78ull, 0x5cda735244c3d43full},
+    {0x9defbf01b061adabull, 0x3a0888136afa64a8ull}, {0xc56baec21c7a1916ull, 0x088aaa1845b8fdd1ull},
+    {0xf6c69a72a3989f5bull, 0x8aad549e57273d46ull}, {0x9a3c2087a63f6399ull, 0x36ac54e2f678864cull},
+    {0xc0cb28a98fcf3c7full, 0x84576a1bb416a7deull}, {0xf0fdf2d3f3c30b9full, 0x656d44a2a11c51d6ull},
+    {0x969eb7c47859e743ull, 0x9f644ae5a4b1b326ull}, {0xbc4665b596706114ull, 0x873d5d9f0dde1fefull},
+    {0xeb57ff22fc0c7959ull, 0xa90cb506d155a7ebull}, {0x9316ff75dd87cbd8ull, 0x09a7f12442d588f3ull},
+    {0xb7dcbf5354e9beceull, 0x0c11ed6d538aeb30ull}, {0xe5d3ef282a242e81ull, 0x8f1668c8a86da5fbull},
+    {0x8fa475791a569d10ull, 0xf96e017d694487bdull}, {0xb38d92d760ec4455ull, 0x37c981dcc395a9adull},
+    {0xe070f78d3927556aull, 0x85bbe253f47b1418ull}, {0x8c469ab843b89562ull, 0x93956d7478ccec8full},
+    {0xaf58416654a6babbull, 0x387ac8d1970027b3ull}, {0xdb2e51bfe9d0696aull, 0x06997b05fcc0319full},
+    {0x88fcf317f22241e2ull, 0x441fece3bdf81f04ull}, {0xab3c2fddeeaad25aull, 0xd527e81cad7626c4ull},
+    {0xd60b3bd56a5586f1ull, 0x8a71e223d8d3b075ull}, {0x85c7056562757456ull, 0xf6872d5667844e4aull},
+    {0xa738c6bebb12d16cull, 0xb428f8ac016561dcull}, {0xd106f86e69d785c7ull, 0xe13336d701beba53ull},
+    {0x82a45b450226b39cull, 0xecc0024661173474ull}, {0xa34d721642b06084ull, 0x27f002d7f95d0191ull},
+    {0xcc20ce9bd35c78a5ull, 0x31ec038df7b441f5ull}, {0xff290242c83396ceull, 0x7e67047175a15272ull},
+    {0x9f79a169bd203e41ull, 0x0f0062c6e984d387ull}, {0xc75809c42c684dd1ull, 0x52c07b78a3e60869ull},
+    {0xf92e0c3537826145ull, 0xa7709a56ccdf8a83ull}, {0x9bbcc7a142b17ccbull, 0x88a66076400bb692ull},
+    {0xc2abf989935ddbfeull, 0x6acff893d00ea436ull}, {0xf356f7ebf83552feull, 0x0583f6b8c4124d44ull},
+    {0x98165af37b2153deull, 0xc3727a337a8b704bull}, {0xbe1bf1b059e9a8d6ull, 0x744f18c0592e4c5dull},
+    {0xeda2ee1c7064130cull, 0x1162def06f79df74ull}, {0x9485d4d1c63e8be7ull, 0x8addcb5645ac2ba9ull},
+    {0xb9a74a0637ce2ee1ull, 0x6d953e2bd7173693ull}, {0xe8111c87c5c1ba99ull, 0xc8fa8db6ccdd0438ull},
+    {0x910ab1d4db9914a0ull, 0x1d9c9892400a22a3ull}, {0xb54d5e4a127f59c8ull, 0x2503beb6d00cab4cull},
+    {0xe2a0b5dc971f303aull, 0x2e44ae64840fd61eull}, {0x8da471a9de737e24ull, 0x5ceaecfed289e5d3ull},
+    {0xb10d8e1456105dadull, 0x7425a83e872c5f48ull}, {0xdd50f1996b947518ull, 0xd12f124e28f7771aull},
+    {0x8a5296ffe33cc92full, 0x82bd6b70d99aaa70ull}, {0xace73cbfdc0bfb7bull, 0x636cc64d1001550cull},
+    {0xd8210befd30efa5aull, 0x3c47f7e05401aa4full}, {0x8714a775e3e95c78ull, 0x65acfaec34810a72ull},
+    {0xa8d9d1535ce3b396ull, 0x7f1839a741a14d0eull}, {0xd31045a8341ca07cull, 0x1ede48111209a051ull},
+    {0x83ea2b892091e44dull, 0x934aed0aab460433ull}, {0xa4e4b66b68b65d60ull, 0xf81da84d56178540ull},
+    {0xce1de40642e3f4b9ull, 0x36251260ab9d668full}, {0x80d2ae83e9ce78f3ull, 0xc1d72b7c6b42601aull},
+    {0xa1075a24e4421730ull, 0xb24cf65b8612f820ull}, {0xc94930ae1d529cfcull, 0xdee033f26797b628ull},
+    {0xfb9b7cd9a4a7443cull, 0x169840ef017da3b2ull}, {0x9d412e0806e88aa5ull, 0x8e1f289560ee864full},
+    {0xc491798a08a2ad4eull, 0xf1a6f2bab92a27e3ull}, {0xf5b5d7ec8acb58a2ull, 0xae10af696774b1dcull},
+    {0x9991a6f3d6bf1765ull, 0xacca6da1e0a8ef2aull}, {0xbff610b0cc6edd3full, 0x17fd090a58d32af4ull},
+    {0xeff394dcff8a948eull, 0xddfc4b4cef07f5b1ull}, {0x95f83d0a1fb69cd9ull, 0x4abdaf101564f98full},
+    {0xbb764c4ca7a4440full, 0x9d6d1ad41abe37f2ull}, {0xea53df5fd18d5513ull, 0x84c86189216dc5eeull},
+    {0x92746b9be2f8552cull, 0x32fd3cf5b4e49bb5ull}, {0xb7118682dbb66a77ull, 0x3fbc8c33221dc2a2ull},
+    {0xe4d5e82392a40515ull, 0x0fabaf3feaa5334bull}, {0x8f05b1163ba6832dull, 0x29cb4d87f2a7400full},
+    {0xb2c71d5bca9023f8ull, 0x743e20e9ef511013ull}, {0xdf78e4b2bd342cf6ull, 0x914da9246b255417ull},
+    {0x8bab8eefb6409c1aull, 0x1ad089b6c2f7548full}, {0xae9672aba3d0c320ull, 0xa184ac2473b529b2ull},
+    {0xda3c0f568cc4f3e8ull, 0xc9e5d72d90a2741full}, {0x8865899617fb1871ull, 0x7e2fa67c7a658893ull},
+    {0xaa7eebfb9df9de8dull, 0xddbb901b98feeab8ull}, {0xd51ea6fa85785631ull, 0x552a74227f3ea566ull},
+    {0x8533285c936b35deull, 0xd53a88958f872760ull}, {0xa67ff273b8460356ull, 0x8a892abaf368f138ull},
+    {0xd01fef10a657842cull, 0x2d2b7569b0432d86ull}, {0x8213f56a67f6b29bull, 0x9c3b29620e29fc74ull},
+    {0xa298f2c501f45f42ull, 0x8349f3ba91b47b90ull}, {0xcb3f2f7642717713ull, 0x241c70a936219a74ull},
+    {0xfe0efb53d30dd4d7ull, 0xed238cd383aa0111ull}, {0x9ec95d1463e8a506ull, 0xf4363804324a40abull},
+    {0xc67bb4597ce2ce48ull, 0xb143c6053edcd0d6ull}, {0xf81aa16fdc1b81daull, 0xdd94b7868e94050bull},
+    {0x9b10a4e5e9913128ull, 0xca7cf2b4191c8327ull}, {0xc1d4ce1f63f57d72ull, 0xfd1c2f611f63a3f1ull},
+    {0xf24a01a73cf2dccfull, 0xbc633b39673c8cedull}, {0x976e41088617ca01ull, 0xd5be0503e085d814ull},
+    {0xbd49d14aa79dbc82ull, 0x4b2d8644d8a74e19ull}, {0xec9c459d51852ba2ull, 0xddf8e7d60ed1219full},
+    {0x93e1ab8252f33b45ull, 0xcabb90e5c942b504ull}, {0xb8da1662e7b00a17ull, 0x3d6a751f3b936244ull},
+    {0xe7109bfba19c0c9dull, 0x0cc512670a783ad5ull}, {0x906a617d450187e2ull, 0x27fb2b80668b24c6ull},
+    {0xb484f9dc9641e9daull, 0xb1f9f660802dedf7ull}, {0xe1a63853bbd26451ull, 0x5e7873f8a0396974ull},
+    {0x8d07e33455637eb2ull, 0xdb0b487b6423e1e9ull}, {0xb049dc016abc5e5full, 0x91ce1a9a3d2cda63ull},
+    {0xdc5c5301c56b75f7ull, 0x7641a140cc7810fcull}, {0x89b9b3e11b6329baull, 0xa9e904c87fcb0a9eull},
+    {0xac2820d9623bf429ull, 0x546345fa9fbdcd45ull}, {0xd732290fbacaf133ull, 0xa97c177947ad4096ull},
+    {0x867f59a9d4bed6c0ull, 0x49ed8eabcccc485eull}, {0xa81f301449ee8c70ull, 0x5c68f256bfff5a75ull},
+    {0xd226fc195c6a2f8cull, 0x73832eec6fff3112ull}, {0x83585d8fd9c25db7ull, 0xc831fd53c5ff7eacull},
+    {0xa42e74f3d032f525ull, 0xba3e7ca8b77f5e56ull}, {0xcd3a1230c43fb26full, 0x28ce1bd2e55f35ecull},
+    {0x80444b5e7aa7cf85ull, 0x7980d163cf5b81b4ull}, {0xa0555e361951c366ull, 0xd7e105bcc3326220ull},
+    {0xc86ab5c39fa63440ull, 0x8dd9472bf3fefaa8ull}, {0xfa856334878fc150ull, 0xb14f98f6f0feb952ull},
+    {0x9c935e00d4b9d8d2ull, 0x6ed1bf9a569f33d4ull}, {0xc3b8358109e84f07ull, 0x0a862f80ec4700c9ull},
+    {0xf4a642e14c6262c8ull, 0xcd27bb612758c0fbull}, {0x98e7e9cccfbd7dbdull, 0x8038d51cb897789dull},
+    {0xbf21e44003acdd2cull, 0xe0470a63e6bd56c4ull}, {0xeeea5d5004981478ull, 0x1858ccfce06cac75ull},
+    {0x95527a5202df0ccbull, 0x0f37801e0c43ebc9ull}, {0xbaa718e68396cffdull, 0xd30560258f54e6bbull},
+    {0xe950df20247c83fdull, 0x47c6b82ef32a206aull}, {0x91d28b7416cdd27eull, 0x4cdc331d57fa5442ull},
+    {0xb6472e511c81471dull, 0xe0133fe4adf8e953ull}, {0xe3d8f9e563a198e5ull, 0x58180fddd97723a7ull},
+    {0x8e679c2f5e44ff8full, 0x570f09eaa7ea7649ull}, {0xb201833b35d63f73ull, 0x2cd2cc6551e513dbull},
+    {0xde81e40a034bcf4full, 0xf8077f7ea65e58d2ull}, {0x8b112e86420f6191ull, 0xfb04afaf27faf783ull},
+    {0xadd57a27d29339f6ull, 0x79c5db9af1f9b564ull}, {0xd94ad8b1c7380874ull, 0x18375281ae7822bdull},
+    {0x87cec76f1c830548ull, 0x8f2293910d0b15b6ull}, {0xa9c2794ae3a3c69aull, 0xb2eb3875504ddb23ull},
+    {0xd433179d9c8cb841ull, 0x5fa60692a46151ecull}, {0x849feec281d7f328ull, 0xdbc7c41ba6bcd334ull},
+    {0xa5c7ea73224deff3ull, 0x12b9b522906c0801ull}, {0xcf39e50feae16befull, 0xd768226b34870a01ull},
+    {0x81842f29f2cce375ull, 0xe6a1158300d46641ull}, {0xa1e53af46f801c53ull, 0x60495ae3c1097fd1ull},
+    {0xca5e89b18b602368ull, 0x385bb19cb14bdfc5ull}, {0xfcf62c1dee382c42ull, 0x46729e03dd9ed7b6ull},
+    {0x9e19db92b4e31ba9ull, 0x6c07a2c26a8346d2ull}, {0xc5a05277621be293ull, 0xc7098b7305241886ull},
+    {0xf70867153aa2db38ull, 0xb8cbee4fc66d1ea8ull},
+};
+
+// floor(log10(2^e)), floor(log10(3/4 2^e)) and floor(log2(10^e)) for the exponents in question.
+static inline int32_t dawn__floor_log10_pow2(int32_t e, bool three_quarters) {
+    return (e * 1262611 - (three_quarters ? 524031 : 0)) >> 22;
+}
+
+static inline int32_t dawn__floor_log2_pow10(int32_t e) {
+    return (e * 1741647) >> 19;
+}
+
+static inline uint64_t dawn__round_to_odd_u64(Dawn__U128 g, uint64_t cp) {
+    uint64_t x_hi, y_hi;
+    dawn__mul128(g.lo, cp, &x_hi);
+    uint64_t y_lo = dawn__mul128(g.hi, cp, &y_hi);
+    uint64_t mid = y_lo + x_hi;
+    y_hi += mid < y_lo;
+    return y_hi | (mid > 1);
+}
+
+static inline uint32_t dawn__round_to_odd_u32(uint64_t g, uint32_t cp) {
+    uint64_t lo = (uint64_t)cp * (g & 0xFFFFFFFF);
+    uint64_t hi = (uint64_t)cp * (g >> 32) + (lo >> 32);
+    return (uint32_t)(hi >> 32) | ((hi & 0xFFFFFFFF) > 1);
+}
+
+// Computes the shortest decimal, digits * 10^exponent, in the rounding
+// interval of the finite positive double c * 2^q.
+static uint64_t dawn__shortest_f64(uint64_t fraction, uint32_t biased_exponent, int32_t *exponent) {
+    uint64_t c;
+    int32_t q;
+    if (biased_exponent != 0) {
+        c = fraction | (1ull << 52);
+        q = (int32_t)biased_exponent - 1075;
+        // Integers are their own shortest representation.
+        if (q <= 0 && q > -53 && (c & ((1ull << -q) - 1)) == 0) {
+            *exponent = 0;
+            return c >> -q;
+        }
+    } else {
+        c = fraction;
+        q = -1074;
+    }
+
+    bool accept_bounds = c % 2 == 0;
+    bool lower_is_closer = fraction == 0 && biased_exponent > 1;
+
+    int32_t k = dawn__floor_log10_pow2(q, lower_is_closer);
+    int32_t h = q + dawn__floor_log2_pow10(-k) + 1;
+    Dawn__U128 g = dawn__pow10_u128[-k - DAWN__POW10_MIN_EXPONENT];
+    uint64_t vbl = dawn__round_to_odd_u64(g, (4 * c - 2 + lower_is_closer) << h);
+    uint64_t vb = dawn__round_to_odd_u64(g, (4 * c) << h);
+    uint64_t vbr = dawn__round_to_odd_u64(g, (4 * c + 2) << h);
+    uint64_t lower = vbl + !accept_bounds;
+    uint64_t upper = vbr - !accept_bounds;
+
+    uint64_t s = vb / 4;
+    if (s >= 10) {
+        uint64_t sp = s / 10;
+        bool up_inside = lower <= 40 * sp;
+        bool wp_inside = 40 * sp + 40 <= upper;
+        if (up_inside != wp_inside) {
+            *exponent = k + 1;
+            return sp + wp_inside;
+        }
+    }
+    bool u_inside = lower <= 4 * s;
+    bool w_inside = 4 * s + 4 <= upper;
+    *exponent = k;
+    if (u_inside != w_inside) return s + w_inside;
+    uint64_t mid = 4 * s + 2;
+    return s + (vb > mid || (vb == mid && (s & 1) != 0));
+}
+
+static uint32_t dawn__shortest_f32(uint32_t fraction, uint32_t biased_exponent, int32_t *exponent) {
+    uint32_t c;
+    int32_t q;
+    if (biased_exponent != 0) {
+        c = fraction | (1u << 23);
+        q = (int32_t)biased_exponent - 150;
+        if (q <= 0 && q > -24 && (c & ((1u << -q) - 1)) == 0) {
+            *exponent = 0;
+            return c >> -q;
+        }
+    } else {
+        c = fraction;
+        q = -149;
+    }
+
+    bool accept_bounds = c % 2 == 0;
+    bool lower_is_closer = fraction == 0 && biased_exponent > 1;
+
+    int32_t k = dawn__floor_log10_pow2(q, lower_is_closer);
+    int32_t h = q + dawn__floor_log2_pow10(-k) + 1;
+    // The upper half of the 128-bit table, rounded up, is the 64-bit table.
+    uint64_t g = dawn__pow10_u128[-k - DAWN__POW10_MIN_EXPONENT].hi + 1;
+    uint32_t vbl = dawn__round_to_odd_u32(g, (4 * c - 2 + lower_is_closer) << h);
+    uint32_t vb = dawn__round_to_odd_u32(g, (4 * c) << h);
+    uint32_t vbr = dawn__round_to_odd_u32(g, (4 * c + 2) << h);
+    uint32_t lower = vbl + !accept_bounds;
+    uint32_t upper = vbr - !accept_bounds;
+
+    uint32_t s = vb / 4;
+    if (s >= 10) {
+        uint32_t sp = s / 10;
+        bool up_inside = lower <= 40 * sp;
+        bool wp_inside = 40 * sp + 40 <= upper;
+        if (up_inside != wp_inside) {
+            *exponent = k + 1;
+            return sp + wp_inside;
+        }
+    }
+    bool u_inside = lower <= 4 * s;
+    bool w_inside = 4 * s + 4 <= upper;
+    *exponent = k;
+    if (u_inside != w_inside) return s + w_inside;
+    uint32_t mid = 4 * s + 2;
+    return s + (vb > mid || (vb == mid && (s & 1) != 0));
+}
+
+// Writes digits * 10^exponent to out and returns the number of bytes written (at most 26).
+static size_t dawn__format_decimal(char *out, bool negative, uint64_t digits, int32_t exponent) {
+    while (digits % 10 == 0 && digits != 0) {
+        digits /= 10;
+        exponent++;
+    }
+
+    char *p = out;
+    if (negative) *p++ = '-';
+
+    int32_t length = (int32_t)dawn__count_digits(digits);
+    // The value is 0.d1d2...dn * 10^point.
+    int32_t point = length + exponent;
+    if (length <= point && point <= 21) {
+        dawn__write_u64(p + length, digits);
+        memset(p + length, '0', point - length);
+        p += point;
+    } else if (0 < point && point <= 21) {
+        dawn__write_u64(p + length + 1, digits);
+        memmove(p, p + 1, point);
+        p[point] = '.';
+        p += length + 1;
+    } else if (-6 < point && point <= 0) {
+        p[0] = '0';
+        p[1] = '.';
+        memset(p + 2, '0', -point);
+        p += 2 - point;
+        dawn__write_u64(p + length, digits);
+        p += length;
+    } else {
+        dawn__write_u64(p + length + 1, digits);
+        p[0] = p[1];
+        if (length > 1) {
+            p[1] = '.';
+            p += length + 1;
+        } else {
+            p += 1;
+        }
+        int32_t e = point - 1;
+        *p++ = 'e';
+        *p++ = e < 0 ? '-' : '+';
+        uint32_t magnitude = e < 0 ? -e : e;
+        size_t e_digits = dawn__count_digits(magnitude);
+        dawn__write_u32(p + e_digits, magnitude);
+        p += e_digits;
+    }
+    return p - out;
+}
+
+static void dawn__append_special(DawnStringBuilder *sb, bool negative, bool non_finite, uint64_t fraction) {
+    if (non_finite && fraction) {
+        DAWN_SB_APPEND_BUF(sb, "nan", 3);
+    } else if (non_finite) {
+        DAWN_SB_APPEND_BUF(sb, negative ? "-inf" : "inf", 3 + negative);
+    } else {
+        DAWN_SB_APPEND_BUF(sb, negative ? "-0" : "0", 1 + negative);
+    }
+}
+
+void dawn_sb_append_f64(DawnStringBuilder *sb, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof bits);
+    bool negative = bits >> 63;
+    uint32_t biased_exponent = (bits >> 52) & 0x7FF;
+    uint64_t fraction = bits & ((1ull << 52) - 1);
+
+    if (biased_exponent == 0x7FF || (biased_exponent == 0 && fraction == 0)) {
+        dawn__append_special(sb, negative, biased_exponent == 0x7FF, fraction);
+        return;
+    }
+
+    int32_t exponent;
+    uint64_t digits = dawn__shortest_f64(fraction, biased_exponent, &exponent);
+    DAWN_DA_RESERVE(sb, 32);
+    sb->length += dawn__format_decimal(sb->items + sb->length, negative, digits, exponent);
+}
+
+void dawn_sb_append_f32(DawnStringBuilder *sb, float value) {
+    uint32_t bits;
+    memcpy(&bits, &value, sizeof bits);
+    bool negative = bits >> 31;
+    uint32_t biased_exponent = (bits >> 23) & 0xFF;
+    uint32_t fraction = bits & ((1u << 23) - 1);
+
+    if (biased_exponent == 0xFF || (biased_exponent == 0 && fraction == 0)) {
+        dawn__append_special(sb, negative, biased_exponent == 0xFF, fraction);
+        return;
+    }
+
+    int32_t exponent;
+    uint32_t digits = dawn__shortest_f32(fraction, biased_exponent, &exponent);
+    DAWN_DA_RESERVE(sb, 32);
+    sb->length += dawn__format_decimal(sb->items + sb->length, negative, digits, exponent);
+}
+
+/********
+ *Search*
+ ********/
+
+#if defined(DAWN_HAS_AVX2)
+#define DAWN__FIND_WIDTH 32
+typedef __m256i DawnFindBlock;
+#define DAWN__FIND_SPLAT(c) _mm256_set1_epi8((char)(c))
+#define DAWN__FIND_MATCH(p, first, last, n)                                                         \
+    (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(                                                \
+        _mm256_cmpeq_epi8(first, _mm256_loadu_si256((const __m256i *)(p))),                          \
+        _mm256_cmpeq_epi8(last, _mm256_loadu_si256((const __m256i *)((p) + (n) - 1)))))
+#elif defined(DAWN_HAS_SSE2)
+#define DAWN__FIND_WIDTH 16
+typedef __m128i DawnFindBlock;
+#define DAWN__FIND_SPLAT(c) _mm_set1_epi8((char)(c))
+#define DAWN__FIND_MATCH(p, first, last, n)                                                         \
+    (uint32_t)_mm_movemask_epi8(_mm_and_si128(                                                      \
+        _mm_cmpeq_epi8(first, _mm_loadu_si128((const __m128i *)(p))),                                \
+        _mm_cmpeq_epi8(last, _mm_loadu_si128((const __m128i *)((p) + (n) - 1)))))
+#endif
+
+static size_t dawn__find_scalar(const char *haystack, size_t haystack_length, size_t start,
+                                const char *needle, size_t needle_length) {
+    const char *end = haystack + haystack_length - needle_length + 1;
+    for (const char *p = haystack + start; p < end; p++) {
+        p = memchr(p, needle[0], end - p);
+        if (!p) break;
+        if (memcmp(p + 1, needle + 1, needle_length - 1) == 0) return p - haystack;
+    }
+    return DAWN_NOT_FOUND;
+}
+
+size_t dawn_find(const char *haystack, size_t haystack_length, const char *needle, size_t needle_length) {
+    if (needle_length == 0) return 0;
+    if (needle_length > haystack_length) return DAWN_NOT_FOUND;
+    if (needle_length == 1) {
+        const char *p = memchr(haystack, needle[0], haystack_length);
+        return p ? (size_t)(p - haystack) : DAWN_NOT_FOUND;
+    }
+
+    size_t i = 0;
+#ifdef DAWN__FIND_WIDTH
+    // Wojciech Mula's "SIMD-friendly algorithms for substring searching":
+    // only positions where both the first and the last byte match are compared in full.
+    DawnFindBlock first = DAWN__FIND_SPLAT(needle[0]);
+    DawnFindBlock last = DAWN__FIND_SPLAT(needle[needle_length - 1]);
+    for (; i + needle_length + DAWN__FIND_WIDTH - 1 <= haystack_length; i += DAWN__FIND_WIDTH) {
+        for (uint32_t m = DAWN__FIND_MATCH(haystack + i, first, last, needle_length); m; m &= m - 1) {
+            size_t pos = i + dawn__ctz32(m);
+            if (memcmp(haystack + pos + 1, needle + 1, needle_length - 2) == 0) return pos;
+        }
+    }
+#endif
+    return dawn__find_scalar(haystack, haystack_length, i, needle, needle_length);
+}
+
+size_t dawn_find_any(const char *haystack, size_t haystack_length,
+                     const DawnStringView *needles, size_t needle_count, size_t *which) {
+    size_t max_length = 0;
+    for (size_t k = 0; k < needle_count; k++) {
+        if (needles[k].length == 0) {
+            if (which) *which = k;
+            return 0;
+        }
+        if (needles[k].length > max_length) max_length = needles[k].length;
+    }
+
+    size_t i = 0;
+#ifdef DAWN__FIND_WIDTH
+    // One first/last byte filter per needle; the union of the candidates is
+    // checked in order so that the leftmost match is found.
+    for (; i + max_length + DAWN__FIND_WIDTH - 1 <= haystack_length; i += DAWN__FIND_WIDTH) {
+        uint32_t candidates = 0;
+        for (size_t k = 0; k < needle_count; k++) {
+            DawnStringView n = needles[k];
+            candidates |= DAWN__FIND_MATCH(haystack + i, DAWN__FIND_SPLAT(n.data[0]),
+                                           DAWN__FIND_SPLAT(n.data[n.length - 1]), n.length);
+        }
+        for (; candidates; candidates &= candidates - 1) {
+            size_t pos = i + dawn__ctz32(candidates);
+            for (size_t k = 0; k < needle_count; k++) {
+                if (memcmp(haystack + pos, needles[k].data, needles[k].length) == 0) {
+                    if (which) *which = k;
+                    return pos;
+                }
+            }
+        }
+    }
+#endif
+    for (; i < haystack_length; i++) {
+        for (size_t k = 0; k < needle_count; k++) {
+            DawnStringView n = needles[k];
+            if (n.length <= haystack_length - i && haystack[i] == n.data[0]
+                && memcmp(haystack + i, n.data, n.length) == 0) {
+                if (which) *which = k;
+                return i;
+            }
+        }
+    }
+    return DAWN_NOT_FOUND;
+}
+
+size_t dawn_sb_replace_all(DawnStringBuilder *sb, DawnStringView from, DawnStringView to) {
+    if (from.length == 0) return 0;
+
+    size_t count = 0;
+    size_t read = 0;
+    size_t delta = 0;
+    if (to.length > from.length) {
+        for (size_t m; (m = dawn_find(sb->items + read, sb->length - read, from.data, from.length)) != DAWN_NOT_FOUND;) {
+            read += m + from.length;
+            count++;
+        }
+        if (count == 0) return 0;
+
+        // Move the content to the end of the grown buffer and rebuild it from
+        // the front. The output never catches up with the unread input.
+        delta = count * (to.length - from.length);
+        DAWN_DA_RESERVE(sb, delta);
+        memmove(sb->items + delta, sb->items, sb->length);
+        count = 0;
+    }
+
+    char *src = sb->items + delta;
+    size_t src_length = sb->length;
+    size_t write = 0;
+    read = 0;
+    for (size_t m; (m = dawn_find(src + read, src_length - read, from.data, from.length)) != DAWN_NOT_FOUND;) {
+        memmove(sb->items + write, src + read, m);
+        write += m;
+        memcpy(sb->items + write, to.data, to.length);
+        write += to.length;
+        read += m + from.length;
+        count++;
+    }
+    memmove(sb->items + write, src + read, src_length - read);
+    sb->length = write + src_length - read;
+    return count;
+}
+
+size_t dawn_sb_append_replaced(DawnStringBuilder *out, DawnStringView src, DawnStringView from, DawnStringView to) {
+    size_t count = 0;
+    if (from.length > 0) {
+        for (size_t m; (m = dawn_find(src.data, src.length, from.data, from.length)) != DAWN_NOT_FOUND;) {
+            DAWN_SB_APPEND_BUF(out, src.data, m);
+            DAWN_SB_APPEND_SV(out, to);
+            dawn_sv_chop_left(&src, m + from.length);
+            count++;
+        }
+    }
+    DAWN_SB_APPEND_SV(out, src);
+    return count;
+}
+
+/*******
+ *UTF-8*
+ *******/
+
+// Returns the offset of the first byte at or after start that does not begin
+// a valid character, or DAWN_NOT_FOUND.
+static size_t dawn__utf8_validate_scalar(const unsigned char *p, size_t length, size_t start) {
+    size_t i = start;
+    while (i < length) {
+        if (length - i >= 8 && (dawn__read64(p + i) & 0x8080808080808080ull) == 0) {
+            i += 8;
+            continue;
+        }
+        unsigned char c = p[i];
+        if (c < 0x80) {
+            i++;
+            continue;
+        }
+
+        size_t need;
+        unsigned char lo = 0x80, hi = 0xBF;
+        if (c < 0xC2) {
+            return i;
+        } else if (c < 0xE0) {
+            need = 1;
+        } else if (c < 0xF0) {
+            need = 2;
+            if (c == 0xE0) lo = 0xA0;
+            if (c == 0xED) hi = 0x9F;
+        } else if (c < 0xF5) {
+            need = 3;
+            if (c == 0xF0) lo = 0x90;
+            if (c == 0xF4) hi = 0x8F;
+        } else {
+            return i;
+        }
+
+        if (length - i <= need) return i;
+        if (p[i + 1] < lo || p[i + 1] > hi) return i;
+        for (size_t k = 2; k <= need; k++) {
+            if ((p[i + k] & 0xC0) != 0x80) return i;
+        }
+        i += need + 1;
+    }
+    return DAWN_NOT_FOUND;
+}
+
+#ifdef DAWN_HAS_AVX2
+// Keiser and Lemire, "Validating UTF-8 In Less Than One Instruction Per Byte",
+// 2021. Each table is indexed by a nibble of the previous or current byte;
+// the AND of the three lookups is nonzero exactly for invalid byte pairs.
+#define DAWN__UTF8_TOO_SHORT  (1 << 0)
+#define DAWN__UTF8_TOO_LONG   (1 << 1)
+#define DAWN__UTF8_OVERLONG_3 (1 << 2)
+#define DAWN__UTF8_TOO_LARGE  (1 << 3)
+#define DAWN__UTF8_SURROGATE  (1 << 4)
+#define DAWN__UTF8_OVERLONG_2 (1 << 5)
+#define DAWN__UTF8_TOO_LARGE_1000 (1 << 6)
+#define DAWN__UTF8_OVERLONG_4 (1 << 6)
+#define DAWN__UTF8_TWO_CONTS  (1 << 7)
+#define DAWN__UTF8_CARRY (DAWN__UTF8_TOO_SHORT | DAWN__UTF8_TOO_LONG | DAWN__UTF8_TWO_CONTS)
+
+#define DAWN__UTF8_TABLE(...) {__VA_ARGS__, __VA_ARGS__}
+
+static const uint8_t dawn__utf8_byte_1_high[32] = DAWN__UTF8_TABLE(
+    // 0_______ ________: ASCII first
+    DAWN__UTF8_TOO_LONG, DAWN__UTF8_TOO_LONG, DAWN__UTF8_TOO_LONG, DAWN__UTF8_TOO_LONG,
+    DAWN__UTF8_TOO_LONG, DAWN__UTF8_TOO_LONG, DAWN__UTF8_TOO_LONG, DAWN__UTF8_TOO_LONG,
+    // 10______ ________: continuation first
+    DAWN__UTF8_TWO_CONTS, DAWN__UTF8_TWO_CONTS, DAWN__UTF8_TWO_CONTS, DAWN__UTF8_TWO_CONTS,
+    // 1100____ ________ and 1101____ ________: two byte lead
+    DAWN__UTF8_TOO_SHORT | DAWN__UTF8_OVERLONG_2,
+    DAWN__UTF8_TOO_SHORT,
+    // 1110____ ________: three byte lead
+    DAWN__UTF8_TOO_SHORT | DAWN__UTF8_OVERLONG_3 | DAWN__UTF8_SURROGATE,
+    // 1111____ ________: four byte lead
+    DAWN__UTF8_TOO_SHORT | DAWN__UTF8_TOO_LARGE | DAWN__UTF8_TOO_LARGE_1000 | DAWN__UTF8_OVERLONG_4);
+
+static const uint8_t dawn__utf8_byte_1_low[32] = DAWN__UTF8_TABLE(
+    // ____0000 ________
+    DAWN__UTF8_CARRY | DAWN__UTF8_OVERLONG_3 | DAWN__UTF8_OVERLONG_2 | DAWN__UTF8_OVERLONG_4,
+    // ____0001 ________
+    DAWN__UTF8_CARRY | DAWN__UTF8_OVERLONG_2,
+    // ____001_ ________
+    DAWN__UTF8_CARRY, DAWN__UTF8_CARRY,
+    // ____0100 ________
+    DAWN__UTF8_CARRY | DAWN__UTF8_TOO_LARGE,
+    // ____0101 ________ to ____1100 ________
+    DAWN__UTF8_CARRY | DAWN__UTF8_TOO_LARGE | DAWN__UTF8_TOO_LARGE_1000,
+    DAWN__UTF8_CARRY | DAWN__UTF8_TOO_LARGE | DAWN__UTF8_TOO_LARGE_1000,
+    DAWN__UTF8_CARRY | DAWN__UTF8_TOO_LARGE | DAWN__UTF8_TOO_LARGE_1000,
+    DAWN__UTF8_CARRY | DAWN__UTF8_TOO_LARGE | DAWN__UTF8_TOO_LARGE_1000,
+    DAWN__UTF8_CARRY | DAWN__UTF8_TOO_LARGE | DAWN__UTF8_TOO_LARGE_1000,
+    DAWN__UTF8_CARRY | DAWN__UTF8_TOO_LARGE | DAWN__UTF8_TOO_LARGE_1000,
+    DAWN__UTF8_CARRY | DAWN__UTF8_TOO_LARGE | DAWN__UTF8_TOO_LARGE_1000,
+    DAWN__UTF8_CARRY | DAWN__UTF8_TOO_LARGE | DAWN__UTF8_TOO_LARGE_1000,
+    // ____1101 ________
+    DAWN__UTF8_CARRY | DAWN__UTF8_TOO_LARGE | DAWN__UTF8_TOO_LARGE_1000 | DAWN__UTF8_SURROGATE,
+    // ____111_ ________
+    DAWN__UTF8_CARRY | DAWN__UTF8_TOO_LARGE | DAWN__UTF8_TOO_LARGE_1000,
+    DAWN__UTF8_CARRY | DAWN__UTF8_TOO_LARGE | DAWN__UTF8_TOO_LARGE_1000);
+
+static const uint8_t dawn__utf8_byte_2_high[32] = DAWN__UTF8_TABLE(
+    // ________ 0_______: ASCII second
+    DAWN__UTF8_TOO_SHORT, DAWN__UTF8_TOO_SHORT, DAWN__UTF8_TOO_SHORT, DAWN__UTF8_TOO_SHORT,
+    DAWN__UTF8_TOO_SHORT, DAWN__UTF8_TOO_SHORT, DAWN__UTF8_TOO_SHORT, DAWN__UTF8_TOO_SHORT,
+    // ________ 1000____
+    DAWN__UTF8_TOO_LONG | DAWN__UTF8_OVERLONG_2 | DAWN__UTF8_TWO_CONTS | DAWN__UTF8_OVERLONG_3
+        | DAWN__UTF8_TOO_LARGE_1000 | DAWN__UTF8_OVERLONG_4,
+    // ________ 1001____
+    DAWN__UTF8_TOO_LONG | DAWN__UTF8_OVERLONG_2 | DAWN__UTF8_TWO_CONTS | DAWN__UTF8_OVERLONG_3 | DAWN__UTF8_TOO_LARGE,
+    // ________ 101_____
+    DAWN__UTF8_TOO_LONG | DAWN__UTF8_OVERLONG_2 | DAWN__UTF8_TWO_CONTS | DAWN__UTF8_SURROGATE | DAWN__UTF8_TOO_LARGE,
+    DAWN__UTF8_TOO_LONG | DAWN__UTF8_OVERLONG_2 | DAWN__UTF8_TWO_CONTS | DAWN__UTF8_SURROGATE | DAWN__UTF8_TOO_LARGE,
+    // ________ 11______: lead second
+    DAWN__UTF8_TOO_SHORT, DAWN__UTF8_TOO_SHORT, DAWN__UTF8_TOO_SHORT, DAWN__UTF8_TOO_SHORT);
+
+// The last three bytes of a block may not start sequences longer than what fits.
+static const uint8_t dawn__utf8_max_value[32] = {
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255,
+    255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1,
+};
+
+#define DAWN__UTF8_PREV(input, prev_input, n) \
+    _mm256_alignr_epi8(input, _mm256_permute2x128_si256(prev_input, input, 0x21), 16 - (n))
+
+static inline __m256i dawn__utf8_block_errors(__m256i input, __m256i prev_input) {
+    const __m256i nibble = _mm256_set1_epi8(0x0F);
+    __m256i prev1 = DAWN__UTF8_PREV(input, prev_input, 1);
+    __m256i byte_1_high = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)dawn__utf8_byte_1_high),
+                                              _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nibble));
+    __m256i byte_1_low = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)dawn__utf8_byte_1_low),
+                                             _mm256_and_si256(prev1, nibble));
+    __m256i byte_2_high = _mm256_shuffle_epi8(_mm256_loadu_si256((const __m256i *)dawn__utf8_byte_2_high),
+                                              _mm256_and_si256(_mm256_srli_epi16(input, 4), nibble));
+    __m256i special_cases = _mm256_and_si256(_mm256_and_si256(byte_1_high, byte_1_low), byte_2_high);
+
+    // Third and fourth bytes of a sequence must be continuations; this
+    // cancels the TWO_CONTS bit where two continuations are expected.
+    __m256i third = _mm256_subs_epu8(DAWN__UTF8_PREV(input, prev_input, 2), _mm256_set1_epi8((char)(0xE0 - 0x80)));
+    __m256i fourth = _mm256_subs_epu8(DAWN__UTF8_PREV(input, prev_input, 3), _mm256_set1_epi8((char)(0xF0 - 0x80)));
+    __m256i must23_80 = _mm256_and_si256(_mm256_or_si256(third, fourth), _mm256_set1_epi8((char)0x80));
+    return _mm256_xor_si256(must23_80, special_cases);
+}
+#endif
+
+bool dawn_utf8_validate(const char *buf, size_t length, size_t *error_offset) {
+    const unsigned char *p = (const unsigned char *)buf;
+    size_t bad = DAWN_NOT_FOUND;
+#ifdef DAWN_HAS_AVX2
+    const __m256i max_value = _mm256_loadu_si256((const __m256i *)dawn__utf8_max_value);
+    __m256i prev_input = _mm256_setzero_si256();
+    __m256i prev_incomplete = _mm256_setzero_si256();
+    for (size_t i = 0;; i += 32) {
+        // The final, partial block is padded with spaces so that a sequence
+        // cut off by the end of the input shows up as too short.
+        bool last = length - i < 32;
+        unsigned char tail[32];
+        __m256i input;
+        if (last) {
+            memset(tail, ' ', sizeof tail);
+            if (length > i) memcpy(tail, p + i, length - i);
+            input = _mm256_loadu_si256((const __m256i *)tail);
+        } else {
+            input = _mm256_loadu_si256((const __m256i *)(p + i));
+        }
+
+        __m256i error;
+        if (_mm256_movemask_epi8(input) == 0) {
+            error = prev_incomplete;
+        } else {
+            error = dawn__utf8_block_errors(input, prev_input);
+            prev_incomplete = _mm256_subs_epu8(input, max_value);
+        }
+        prev_input = input;
+
+        if (!_mm256_testz_si256(error, error)) {
+            // The error may belong to a sequence started in the previous
+            // block, so rescan from the last character boundary before this one.
+            size_t start = i >= 3 ? i - 3 : 0;
+            while (start < i && (p[start] & 0xC0) == 0x80) start++;
+            bad = dawn__utf8_validate_scalar(p, length, start);
+            break;
+        }
+        if (last) break;
+    }
+#else
+    bad = dawn__utf8_validate_scalar(p, length, 0);
+#endif
+    if (bad == DAWN_NOT_FOUND) return true;
+    if (error_offset) *error_offset = bad;
+    return false;
+}
+
+size_t dawn_utf8_count(const char *buf, size_t length) {
+    const unsigned char *p = (const unsigned char *)buf;
+    size_t continuations = 0;
+    size_t i = 0;
+#ifdef DAWN_HAS_AVX2
+    // Continuation bytes are exactly those below -64 as signed bytes.
+    const __m256i limit = _mm256_set1_epi8(-64);
+    for (; i + 32 <= length; i += 32) {
+        __m256i input = _mm256_loadu_si256((const __m256i *)(p + i));
+        uint32_t m = (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi8(limit, input));
+        continuations += dawn__popcount64(m);
+    }
+#endif
+    for (; i + 8 <= length; i += 8) {
+        uint64_t v = dawn__read64(p + i);
+        continuations += dawn__popcount64(v & ~(v << 1) & 0x8080808080808080ull);
+    }
+    for (; i < length; i++) {
+        continuations += (p[i] & 0xC0) == 0x80;
+    }
+    return length - continuations;
+}
+
+/**********
+ *Encoding*
+ **********/
+
+// The SIMD base64 kernels follow W. Mula and D. Lemire, "Faster Base64
+// Encoding and Decoding Using AVX2 Instructions", 2018.
+
+#ifdef DAWN_HAS_SSSE3
+// Spreads 12 bytes over 16 lanes of 6-bit indices and maps them to ASCII.
+static inline __m128i dawn__base64_encode_lane(__m128i in, __m128i shift_lut) {
+    in = _mm_shuffle_epi8(in, _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1));
+    __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+    __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+    __m128i indices = _mm_or_si128(t0, t1);
+    __m128i result = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+    __m128i less = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+    result = _mm_or_si128(result, _mm_and_si128(less, _mm_set1_epi8(13)));
+    return _mm_add_epi8(_mm_shuffle_epi8(shift_lut, result), indices);
+}
+
+static inline __m128i dawn__base64_shift_lut(DawnBase64Alphabet alphabet) {
+    char c62 = alphabet == DAWN_BASE64_URL ? '-' : '+';
+    char c63 = alphabet == DAWN_BASE64_URL ? '_' : '/';
+    return _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+                         '0' - 52, '0' - 52, '0' - 52, (char)(c62 - 62), (char)(c63 - 63), 'A', 0, 0);
+}
+#endif
+
+#ifdef DAWN_HAS_AVX2
+static inline __m256i dawn__base64_decode_block(__m256i str, DawnBase64Alphabet alphabet, bool *valid) {
+    const __m256i lut_lo = _mm256_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lut_hi = _mm256_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lut_roll = _mm256_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i mask_2f = _mm256_set1_epi8(0x2F);
+
+    if (alphabet == DAWN_BASE64_URL) {
+        // Map '-' and '_' onto '+' and '/', and those two onto an invalid byte.
+        __m256i standard = _mm256_or_si256(_mm256_cmpeq_epi8(str, _mm256_set1_epi8('+')),
+                                           _mm256_cmpeq_epi8(str, mask_2f));
+        str = _mm256_andnot_si256(standard, str);
+        str = _mm256_sub_epi8(str, _mm256_and_si256(_mm256_cmpeq_epi8(str, _mm256_set1_epi8('-')), _mm256_set1_epi8('-' - '+')));
+        str = _mm256_sub_epi8(str, _mm256_and_si256(_mm256_cmpeq_epi8(str, _mm256_set1_epi8('_')), _mm256_set1_epi8('_' - '/')));
+    }
+
+    __m256i hi_nibbles = _mm256_and_si256(_mm256_srli_epi32(str, 4), mask_2f);
+    __m256i lo_nibbles = _mm256_and_si256(str, mask_2f);
+    __m256i hi = _mm256_shuffle_epi8(lut_hi, hi_nibbles);
+    __m256i lo = _mm256_shuffle_epi8(lut_lo, lo_nibbles);
+    *valid = _mm256_testz_si256(lo, hi);
+
+    __m256i eq_2f = _mm256_cmpeq_epi8(str, mask_2f);
+    __m256i roll = _mm256_shuffle_epi8(lut_roll, _mm256_add_epi8(eq_2f, hi_nibbles));
+    str = _mm256_add_epi8(str, roll);
+
+    // Pack four 6-bit values into three bytes per 32-bit lane.
+    str = _mm256_maddubs_epi16(str, _mm256_set1_epi32(0x01400140));
+    str = _mm256_madd_epi16(str, _mm256_set1_epi32(0x00011000));
+    str = _mm256_shuffle_epi8(str, _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+    return _mm256_permutevar8x32_epi32(str, _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7));
+}
+#elif defined(DAWN_HAS_SSSE3)
+static inline __m128i dawn__base64_decode_block(__m128i str, DawnBase64Alphabet alphabet, bool *valid) {
+    const __m128i lut_lo = _mm_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lut_hi = _mm_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lut_roll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i mask_2f = _mm_set1_epi8(0x2F);
+
+    if (alphabet == DAWN_BASE64_URL) {
+        __m128i standard = _mm_or_si128(_mm_cmpeq_epi8(str, _mm_set1_epi8('+')), _mm_cmpeq_epi8(str, mask_2f));
+        str = _mm_andnot_si128(standard, str);
+        str = _mm_sub_epi8(str, _mm_and_si128(_mm_cmpeq_epi8(str, _mm_set1_epi8('-')), _mm_set1_epi8('-' - '+')));
+        str = _mm_sub_epi8(str, _mm_and_si128(_mm_cmpeq_epi8(str, _mm_set1_epi8('_')), _mm_set1_epi8('_' - '/')));
+    }
+
+    __m128i hi_nibbles = _mm_and_si128(_mm_srli_epi32(str, 4), mask_2f);
+    __m128i lo_nibbles = _mm_and_si128(str, mask_2f);
+    __m128i hi = _mm_shuffle_epi8(lut_hi, hi_nibbles);
+    __m128i lo = _mm_shuffle_epi8(lut_lo, lo_nibbles);
+    *valid = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) == 0xFFFF;
+
+    __m128i eq_2f = _mm_cmpeq_epi8(str, mask_2f);
+    __m128i roll = _mm_shuffle_epi8(lut_roll, _mm_add_epi8(eq_2f, hi_nibbles));
+    str = _mm_add_epi8(str, roll);
+
+    str = _mm_maddubs_epi16(str, _mm_set1_epi32(0x01400140));
+    str = _mm_madd_epi16(str, _mm_set1_epi32(0x00011000));
+    return _mm_shuffle_epi8(str, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+}
+#endif
+
+// Values of the standard alphabet; -1 marks bytes outside it.
+static const int8_t dawn__base64_values[256] = {
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 62, -1, -1, -1, 63,
+    52, 53, 54, 55, 56, 57, 58, 59, 60, 61, -1, -1, -1, -1, -1, -1,
+    -1,  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14,
+    15, 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, -1, -1, -1, -1, -1,
+    -1, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40,
+    41, 42, 43, 44, 45, 46, 47, 48, 49, 50, 51, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+};
+
+static inline int dawn__base64_value(unsigned char c, DawnBase64Alphabet alphabet) {
+    if (alphabet == DAWN_BASE64_URL) {
+        c = c == '-' ? '+' : c == '_' ? '/' : c == '+' || c == '/' ? 0 : c;
+    }
+    return dawn__base64_values[c];
+}
+
+void dawn_sb_append_base64(DawnStringBuilder *sb, const void *data, size_t length, DawnBase64Alphabet alphabet) {
+    const char *digits = alphabet == DAWN_BASE64_URL
+        ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+        : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    bool pad = alphabet == DAWN_BASE64_STANDARD;
+    size_t rem = length % 3;
+    size_t out_length = length / 3 * 4 + (rem == 0 ? 0 : pad ? 4 : rem + 1);
+    DAWN_DA_RESERVE(sb, out_length);
+
+    const unsigned char *in = data;
+    char *out = sb->items + sb->length;
+    size_t i = 0;
+#ifdef DAWN_HAS_SSSE3
+    __m128i shift_lut = dawn__base64_shift_lut(alphabet);
+#ifdef DAWN_HAS_AVX2
+    // Each 128-bit load reads 16 bytes but only encodes the first 12.
+    for (; i + 28 <= length; i += 24, out += 32) {
+        __m128i lo = dawn__base64_encode_lane(_mm_loadu_si128((const __m128i *)(in + i)), shift_lut);
+        __m128i hi = dawn__base64_encode_lane(_mm_loadu_si128((const __m128i *)(in + i + 12)), shift_lut);
+        _mm256_storeu_si256((__m256i *)out, _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1));
+    }
+#endif
+    for (; i + 16 <= length; i += 12, out += 16) {
+        _mm_storeu_si128((__m128i *)out, dawn__base64_encode_lane(_mm_loadu_si128((const __m128i *)(in + i)), shift_lut));
+    }
+#endif
+    for (; i + 3 <= length; i += 3, out += 4) {
+        uint32_t v = (uint32_t)in[i] << 16 | (uint32_t)in[i + 1] << 8 | in[i + 2];
+        out[0] = digits[v >> 18];
+        out[1] = digits[(v >> 12) & 63];
+        out[2] = digits[(v >> 6) & 63];
+        out[3] = digits[v & 63];
+    }
+    if (rem > 0) {
+        uint32_t v = (uint32_t)in[i] << 16 | (rem == 2 ? (uint32_t)in[i + 1] << 8 : 0);
+        *out++ = digits[v >> 18];
+        *out++ = digits[(v >> 12) & 63];
+        if (rem == 2) *out++ = digits[(v >> 6) & 63];
+        if (pad) {
+            if (rem == 1) *out++ = '=';
+            *out++ = '=';
+        }
+    }
+    sb->length += out_length;
+}
+
+bool dawn_sb_append_base64_decoded(DawnStringBuilder *sb, const char *text, size_t length, DawnBase64Alphabet alphabet) {
+    if (length % 4 == 0 && length > 0 && text[length - 1] == '=') {
+        length -= text[length - 2] == '=' ? 2 : 1;
+    }
+    if (length % 4 == 1) return false;
+    size_t out_length = length / 4 * 3 + (length % 4 ? length % 4 - 1 : 0);
+    // The vector stores write a few bytes past the decoded ones.
+    DAWN_DA_RESERVE(sb, out_length + 8);
+
+    const unsigned char *in = (const unsigned char *)text;
+    unsigned char *out = (unsigned char *)sb->items + sb->length;
+    size_t i = 0;
+    bool valid = true;
+#if defined(DAWN_HAS_AVX2)
+    for (; i + 32 <= length; i += 32, out += 24) {
+        __m256i block = dawn__base64_decode_block(_mm256_loadu_si256((const __m256i *)(in + i)), alphabet, &valid);
+        if (!valid) break;
+        _mm256_storeu_si256((__m256i *)out, block);
+    }
+#elif defined(DAWN_HAS_SSSE3)
+    for (; i + 16 <= length; i += 16, out += 12) {
+        __m128i block = dawn__base64_decode_block(_mm_loadu_si128((const __m128i *)(in + i)), alphabet, &valid);
+        if (!valid) break;
+        _mm_storeu_si128((__m128i *)out, block);
+    }
+#endif
+    (void)valid;
+    // Invalid bytes are negative, so or-ing every value flags them at once.
+    int bad = 0;
+    for (; i + 4 <= length; i += 4, out += 3) {
+        int a = dawn__base64_value(in[i], alphabet);
+        int b = dawn__base64_value(in[i + 1], alphabet);
+        int c = dawn__base64_value(in[i + 2], alphabet);
+        int d = dawn__base64_value(in[i + 3], alphabet);
+        bad |= a | b | c | d;
+        uint32_t v = (uint32_t)a << 18 | (uint32_t)b << 12 | (uint32_t)c << 6 | (uint32_t)d;
+        out[0] = (unsigned char)(v >> 16);
+        out[1] = (unsigned char)(v >> 8);
+        out[2] = (unsigned char)v;
+    }
+    if (i < length) {
+        int a = dawn__base64_value(in[i], alphabet);
+        int b = dawn__base64_value(in[i + 1], alphabet);
+        int c = length - i == 3 ? dawn__base64_value(in[i + 2], alphabet) : 0;
+        bad |= a | b | c;
+        uint32_t v = (uint32_t)a << 18 | (uint32_t)b << 12 | (uint32_t)c << 6;
+        // The bits below the last decoded byte must be zero, so that every
+        // byte string has exactly one encoding ("QQ==" but not "QR==").
+        if (v & (length - i == 3 ? 0xFFu : 0xFFFFu)) bad = -1;
+        out[0] = (unsigned char)(v >> 16);
+        if (length - i == 3) out[1] = (unsigned char)(v >> 8);
+    }
+    if (bad < 0) return false;
+    sb->length += out_length;
+    return true;
+}
+
+void dawn_sb_append_hex_bytes(DawnStringBuilder *sb, const void *data, size_t length) {
+    static const char hex_digits[16] = "0123456789abcdef";
+    DAWN_DA_RESERVE(sb, 2 * length);
+    const unsigned char *in = data;
+    char *out = sb->items + sb->length;
+    size_t i = 0;
+#if defined(DAWN_HAS_AVX2)
+    const __m256i lut = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+                                         '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    for (; i + 16 <= length; i += 16) {
+        // Widen each byte to 16 bits and put its high nibble first.
+        __m256i x = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(in + i)));
+        __m256i nibbles = _mm256_or_si256(_mm256_srli_epi16(x, 4), _mm256_slli_epi16(_mm256_and_si256(x, _mm256_set1_epi16(0x0F)), 8));
+        _mm256_storeu_si256((__m256i *)(out + 2 * i), _mm256_shuffle_epi8(lut, nibbles));
+    }
+#elif defined(DAWN_HAS_SSSE3)
+    const __m128i lut = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    for (; i + 16 <= length; i += 16) {
+        __m128i x = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i hi = _mm_shuffle_epi8(lut, _mm_and_si128(_mm_srli_epi16(x, 4), _mm_set1_epi8(0x0F)));
+        __m128i lo = _mm_shuffle_epi8(lut, _mm_and_si128(x, _mm_set1_epi8(0x0F)));
+        _mm_storeu_si128((__m128i *)(out + 2 * i), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128((__m128i *)(out + 2 * i + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+#endif
+    for (; i < length; i++) {
+        out[2 * i] = hex_digits[in[i] >> 4];
+        out[2 * i + 1] = hex_digits[in[i] & 0x0F];
+    }
+    sb->length += 2 * length;
+}
+
+// Branch-free: the result is -1 when c is neither a digit nor a letter a-f.
+static inline int dawn__hex_value(unsigned char c) {
+    int digit = c - '0';
+    int alpha = (c | 0x20) - 'a' + 10;
+    int is_digit = (unsigned)digit < 10;
+    int is_alpha = (unsigned)(alpha - 10) < 6;
+    return (digit & -is_digit) | (alpha & -is_alpha) | -(1 - (is_digit | is_alpha));
+}
+
+bool dawn_sb_append_hex_decoded(DawnStringBuilder *sb, const char *text, size_t length) {
+    if (length % 2 != 0) return false;
+    DAWN_DA_RESERVE(sb, length / 2);
+    const unsigned char *in = (const unsigned char *)text;
+    unsigned char *out = (unsigned char *)sb->items + sb->length;
+    size_t i = 0;
+#ifdef DAWN_HAS_SSSE3
+    for (; i + 16 <= length; i += 16) {
+        __m128i c = _mm_loadu_si128((const __m128i *)(in + i));
+        __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+        __m128i is_digit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+        __m128i is_alpha = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lower));
+        if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) != 0xFFFF) break;
+        __m128i values = _mm_or_si128(_mm_and_si128(is_digit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+                                      _mm_and_si128(is_alpha, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+        // high * 16 + low for each pair of digits, then narrow to bytes.
+        __m128i bytes = _mm_maddubs_epi16(values, _mm_set1_epi16(0x0110));
+        _mm_storel_epi64((__m128i *)(out + i / 2), _mm_packus_epi16(bytes, bytes));
+    }
+#endif
+    int bad = 0;
+    for (; i < length; i += 2) {
+        int hi = dawn__hex_value(in[i]);
+        int lo = dawn__hex_value(in[i + 1]);
+        bad |= hi | lo;
+        out[i / 2] = (unsigned char)((unsigned)hi << 4 | (unsigned)lo);
+    }
+    if (bad < 0) return false;
+    sb->length += length / 2;
+    return true;
+}
+
+/****************
+ *Number parsing*
+ ****************/
+
+static inline bool dawn__is_digit(char c) {
+    return (unsigned)(c - '0') < 10;
+}
+
+#ifdef DAWN_LITTLE_ENDIAN
+static inline bool dawn__is_eight_digits(uint64_t v) {
+    return ((v & 0xF0F0F0F0F0F0F0F0ull) | (((v + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4))
+        == 0x3333333333333333ull;
+}
+
+// Converts eight ASCII digits in one go (SWAR); see Lemire, "Number Parsing
+// at a Gigabyte per Second", 2021.
+static inline uint32_t dawn__parse_eight_digits(uint64_t v) {
+    const uint64_t mask = 0x000000FF000000FFull;
+    const uint64_t mul1 = 100 + (1000000ull << 32);
+    const uint64_t mul2 = 1 + (10000ull << 32);
+    v -= 0x3030303030303030ull;
+    v = v * 10 + (v >> 8);
+    return (uint32_t)((((v & mask) * mul1) + (((v >> 16) & mask) * mul2)) >> 32);
+}
+#endif
+
+// Accumulates the digits starting at p into *w until it holds 19 significant
+// digits. The rest of the digits are skipped. Returns the end of the digits;
+// *taken is how many of them went into *w.
+static const char *dawn__scan_digits(const char *p, const char *end, uint64_t *w, size_t *taken, bool *dropped_nonzero) {
+    const char *start = p;
+#ifdef DAWN_LITTLE_ENDIAN
+    while (end - p >= 8 && *w < 100000000000ull) {
+        uint64_t chunk = dawn__read64((const unsigned char *)p);
+        if (!dawn__is_eight_digits(chunk)) break;
+        *w = *w * 100000000 + dawn__parse_eight_digits(chunk);
+        p += 8;
+    }
+#endif
+    while (p < end && dawn__is_digit(*p) && *w < 1000000000000000000ull) {
+        *w = *w * 10 + (uint64_t)(*p - '0');
+        p++;
+    }
+    *taken = p - start;
+    while (p < end && dawn__is_digit(*p)) {
+        if (*p != '0') *dropped_nonzero = true;
+        p++;
+    }
+    return p;
+}
+
+// Parses unsigned digits without a sign. Returns their end, or NULL if
+// there are none or they do not fit.
+static const char *dawn__parse_u64_digits(const char *p, const char *end, uint64_t *value) {
+    uint64_t w = 0;
+    size_t taken;
+    bool dropped_nonzero = false;
+    const char *digits_end = dawn__scan_digits(p, end, &w, &taken, &dropped_nonzero);
+    size_t count = digits_end - p;
+    if (count == 0) return NULL;
+    if (count > taken) {
+        // One more digit after the first 19 significant ones may still fit.
+        if (count - taken > 1) return NULL;
+        uint64_t d = (uint64_t)(p[taken] - '0');
+        if (w > (UINT64_MAX - d) / 10) return NULL;
+        w = w * 10 + d;
+    }
+    *value = w;
+    return digits_end;
+}
+
+size_t dawn_parse_u64(const char *buf, size_t length, uint64_t *value) {
+    const char *p = buf;
+    const char *end = buf + length;
+    if (p < end && *p == '+') p++;
+    p = dawn__parse_u64_digits(p, end, value);
+    return p ? (size_t)(p - buf) : 0;
+}
+
+size_t dawn_parse_i64(const char *buf, size_t length, int64_t *value) {
+    const char *p = buf;
+    const char *end = buf + length;
+    bool negative = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+')) p++;
+
+    uint64_t magnitude;
+    p = dawn__parse_u64_digits(p, end, &magnitude);
+    if (!p || magnitude > (uint64_t)INT64_MAX + negative) return 0;
+
+    *value = negative ? (int64_t)(0 - magnitude) : (int64_t)magnitude;
+    return p - buf;
+}
+
+// Eisel-Lemire: w * 10^q rounded to a double using one or two 64x64-bit
+// multiplications. Fails on the rare inputs it cannot round with certainty,
+// and on subnormal or overflowing results. Follows the Go standard library.
+static bool dawn__eisel_lemire(uint64_t w, int64_t q, double *result) {
+    if (q < DAWN__POW10_MIN_EXPONENT || q > 308) return false;
+
+    // The table is rounded up; the algorithm wants it truncated.
+    Dawn__U128 g = dawn__pow10_u128[q - DAWN__POW10_MIN_EXPONENT];
+    uint64_t t_hi = g.hi - (g.lo == 0);
+    uint64_t t_lo = g.lo - 1;
+
+    unsigned clz = dawn__clz64(w);
+    w <<= clz;
+    uint64_t exp2 = (uint64_t)(((217706 * q) >> 16) + 64 + 1023) - clz;
+
+    uint64_t x_hi;
+    uint64_t x_lo = dawn__mul128(w, t_hi, &x_hi);
+    if ((x_hi & 0x1FF) == 0x1FF && x_lo + w < w) {
+        uint64_t y_hi;
+        uint64_t y_lo = dawn__mul128(w, t_lo, &y_hi);
+        uint64_t merged_hi = x_hi;
+        uint64_t merged_lo = x_lo + y_hi;
+        if (merged_lo < x_lo) merged_hi++;
+        if ((merged_hi & 0x1FF) == 0x1FF && merged_lo + 1 == 0 && y_lo + w < w) return false;
+        x_hi = merged_hi;
+        x_lo = merged_lo;
+    }
+
+    uint64_t msb = x_hi >> 63;
+    uint64_t mantissa = x_hi >> (msb + 9);
+    exp2 -= 1 ^ msb;
+    if (x_lo == 0 && (x_hi & 0x1FF) == 0 && (mantissa & 3) == 1) return false;
+
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >> 53) {
+        mantissa >>= 1;
+        exp2++;
+    }
+    if (exp2 - 1 >= 0x7FF - 1) return false;
+
+    uint64_t bits = exp2 << 52 | (mantissa & ((1ull << 52) - 1));
+    memcpy(result, &bits, sizeof bits);
+    return true;
+}
+
+static size_t dawn__parse_special(const char *p, const char *end, double *value) {
+    static const char *const words[] = {"infinity", "inf", "nan"};
+    for (size_t i = 0; i < 3; i++) {
+        size_t n = strlen(words[i]);
+        if ((size_t)(end - p) < n) continue;
+        size_t j = 0;
+        while (j < n && (p[j] | 0x20) == words[i][j]) j++;
+        if (j == n) {
+            *value = i < 2 ? HUGE_VAL : NAN;
+            return n;
+        }
+    }
+    return 0;
+}
+
+// Correctly rounded fallback for the inputs the fast paths give up on. The
+// digits are handed to strtod without a decimal point, so the locale does
+// not matter.
+static double dawn__parse_f64_slow(const char *int_start, const char *int_end,
+                                   const char *frac_start, const char *frac_end, int64_t exponent) {
+    char local[512];
+    size_t int_digits = int_end - int_start;
+    size_t digits = int_digits + (frac_end - frac_start);
+    char *text = digits + 32 <= sizeof local ? local : malloc(digits + 32);
+    assert(text && "Not enough RAM for malloc");
+    memcpy(text, int_start, int_digits);
+    memcpy(text + int_digits, frac_start, frac_end - frac_start);
+    snprintf(text + digits, 32, "e%lld", (long long)exponent);
+    double result = strtod(text, NULL);
+    if (text != local) free(text);
+    return result;
+}
+
+// Whether double operations round to double, as the exact fast path of
+// dawn_parse_f64 needs. 1 and 16 (_Float16 evaluated as float) do too, 2
+// (x87 long double, e.g. gcc -m32) does not.
+#if FLT_EVAL_METHOD == 0 || FLT_EVAL_METHOD == 1 || FLT_EVAL_METHOD == 16
+#define DAWN__DOUBLE_EVAL_EXACT
+#endif
+
+size_t dawn_parse_f64(const char *buf, size_t length, double *value) {
+#ifdef DAWN__DOUBLE_EVAL_EXACT
+    static const double exact_pow10[23] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+    };
+#endif
+
+    const char *p = buf;
+    const char *end = buf + length;
+    bool negative = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+')) p++;
+
+    // The value is w * 10^q, with w holding up to 19 significant digits.
+    uint64_t w = 0;
+    size_t taken;
+    bool truncated = false;
+
+    const char *int_start = p;
+    const char *int_end = p = dawn__scan_digits(p, end, &w, &taken, &truncated);
+    int64_t q = (int64_t)(int_end - int_start - taken);
+
+    const char *frac_start = p;
+    const char *frac_end = p;
+    if (p < end && *p == '.') {
+        frac_start = p + 1;
+        frac_end = p = dawn__scan_digits(frac_start, end, &w, &taken, &truncated);
+        q -= (int64_t)taken;
+    }
+
+    if (int_start == int_end && frac_start == frac_end) {
+        size_t n = dawn__parse_special(int_start, end, value);
+        if (n == 0) return 0;
+        if (negative) *value = -*value;
+        return int_start + n - buf;
+    }
+
+    int64_t exp_value = 0;
+    if (p < end && (*p | 0x20) == 'e') {
+        const char *e = p + 1;
+        bool exp_negative = e < end && *e == '-';
+        if (e < end && (*e == '-' || *e == '+')) e++;
+        if (e < end && dawn__is_digit(*e)) {
+            for (; e < end && dawn__is_digit(*e); e++) {
+                // Saturate; such exponents overflow or underflow anyway.
+                if (exp_value < 1000000000000000) exp_value = exp_value * 10 + (*e - '0');
+            }
+            if (exp_negative) exp_value = -exp_value;
+            q += exp_value;
+            p = e;
+        }
+    }
+
+    double result;
+    double upper;
+    if (w == 0) {
+        result = 0.0;
+    } else if (q < -342) {
+        // Below half of the smallest subnormal even with 19 digits.
+        result = 0.0;
+    } else if (q > 308) {
+        result = HUGE_VAL;
+#ifdef DAWN__DOUBLE_EVAL_EXACT
+    } else if (!truncated && w <= (1ull << 53) && q >= -22 && q <= 22) {
+        // Both operands are exact, so IEEE division or multiplication rounds correctly.
+        result = q < 0 ? (double)w / exact_pow10[-q] : (double)w * exact_pow10[q];
+#endif
+    } else if (!truncated && dawn__eisel_lemire(w, q, &result)) {
+        // Done.
+    } else if (truncated && dawn__eisel_lemire(w, q, &result) && dawn__eisel_lemire(w + 1, q, &upper)
+               && result == upper) {
+        // The dropped digits could not have changed the rounding.
+    } else {
+        result = dawn__parse_f64_slow(int_start, int_end, frac_start, frac_end,
+                                      exp_value - (int64_t)(frac_end - frac_start));
+    }
+
+    *value = negative ? -result : result;
+    return p - buf;
+}
+
+/******
+ *JSON*
+ ******/
+
+// Offset of the first quote, backslash or control byte at or after i, or length.
+static size_t dawn__json_scan(const char *str, size_t length, size_t i) {
+#if defined(DAWN_HAS_AVX2)
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i backslash = _mm256_set1_epi8('\\');
+    const __m256i control = _mm256_set1_epi8(0x1F);
+    for (; i + 32 <= length; i += 32) {
+        __m256i c = _mm256_loadu_si256((const __m256i *)(str + i));
+        __m256i special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(c, quote), _mm256_cmpeq_epi8(c, backslash)),
+                                          _mm256_cmpeq_epi8(_mm256_min_epu8(c, control), c));
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(special);
+        if (mask) return i + dawn__ctz32(mask);
+    }
+#elif defined(DAWN_HAS_SSE2)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    for (; i + 16 <= length; i += 16) {
+        __m128i c = _mm_loadu_si128((const __m128i *)(str + i));
+        __m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(c, quote), _mm_cmpeq_epi8(c, backslash)),
+                                       _mm_cmpeq_epi8(_mm_min_epu8(c, control), c));
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(special);
+        if (mask) return i + dawn__ctz32(mask);
+    }
+#endif
+    for (; i < length; i++) {
+        unsigned char c = (unsigned char)str[i];
+        if (c == '"' || c == '\\' || c < 0x20) break;
+    }
+    return i;
+}
+
+void dawn_sb_append_json_escaped(DawnStringBuilder *sb, const char *str, size_t length) {
+    static const char hex_digits[16] = "0123456789abcdef";
+    DAWN_DA_RESERVE(sb, length);
+    size_t start = 0;
+    for (;;) {
+        size_t i = dawn__json_scan(str, length, start);
+        DAWN_SB_APPEND_BUF(sb, str + start, i - start);
+        if (i == length) break;
+
+        unsigned char c = (unsigned char)str[i];
+        char escape[6] = {'\\', (char)c, '0', '0', '0', '0'};
+        size_t escape_length = 2;
+        switch (c) {
+        case '"':
+        case '\\':
+            break;
+        case '\b': escape[1] = 'b'; break;
+        case '\f': escape[1] = 'f'; break;
+        case '\n': escape[1] = 'n'; break;
+        case '\r': escape[1] = 'r'; break;
+        case '\t': escape[1] = 't'; break;
+        default:
+            escape[1] = 'u';
+            escape[4] = hex_digits[c >> 4];
+            escape[5] = hex_digits[c & 0x0F];
+            escape_length = 6;
+        }
+        DAWN_SB_APPEND_BUF(sb, escape, escape_length);
+        start = i + 1;
+    }
+}
+
+static inline int32_t dawn__json_hex4(const char *p) {
+    int a = dawn__hex_value((unsigned char)p[0]);
+    int b = dawn__hex_value((unsigned char)p[1]);
+    int c = dawn__hex_value((unsigned char)p[2]);
+    int d = dawn__hex_value((unsigned char)p[3]);
+    if ((a | b | c | d) < 0) return -1;
+    return a << 12 | b << 8 | c << 4 | d;
+}
+
+bool dawn_sb_append_json_unescaped(DawnStringBuilder *sb, const char *str, size_t length) {
+    // Every escape sequence is at least as long as what it decodes to.
+    DAWN_DA_RESERVE(sb, length);
+    char *out = sb->items + sb->length;
+    size_t start = 0;
+    for (;;) {
+        size_t i = dawn__json_scan(str, length, start);
+        memcpy(out, str + start, i - start);
+        out += i - start;
+        if (i == length) break;
+        if (str[i] != '\\' || i + 1 == length) return false;
+
+        start = i + 2;
+        switch (str[i + 1]) {
+        case '"': *out++ = '"'; break;
+        case '\\': *out++ = '\\'; break;
+        case '/': *out++ = '/'; break;
+        case 'b': *out++ = '\b'; break;
+        case 'f': *out++ = '\f'; break;
+        case 'n': *out++ = '\n'; break;
+        case 'r': *out++ = '\r'; break;
+        case 't': *out++ = '\t'; break;
+        case 'u': {
+            if (length - start < 4) return false;
+            int32_t cp = dawn__json_hex4(str + start);
+            start += 4;
+            if (cp < 0 || (cp >= 0xDC00 && cp <= 0xDFFF)) return false;
+            if (cp >= 0xD800 && cp <= 0xDBFF) {
+                if (length - start < 6 || str[start] != '\\' || str[start + 1] != 'u') return false;
+                int32_t low = dawn__json_hex4(str + start + 2);
+                if (low < 0xDC00 || low > 0xDFFF) return false;
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                start += 6;
+            }
+            if (cp < 0x80) {
+                *out++ = (char)cp;
+            } else if (cp < 0x800) {
+                *out++ = (char)(0xC0 | cp >> 6);
+                *out++ = (char)(0x80 | (cp & 0x3F));
+            } else if (cp < 0x10000) {
+                *out++ = (char)(0xE0 | cp >> 12);
+                *out++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+                *out++ = (char)(0x80 | (cp & 0x3F));
+            } else {
+                *out++ = (char)(0xF0 | cp >> 18);
+                *out++ = (char)(0x80 | ((cp >> 12) & 0x3F));
+                *out++ = (char)(0x80 | ((cp >> 6) & 0x3F));
+                *out++ = (char)(0x80 | (cp & 0x3F));
+            }
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    sb->length = (size_t)(out - sb->items);
+    return true;
+}
+
+// Length of the JSON number at the start of p, or 0 if there is none.
+static size_t dawn__json_number_length(const char *p, size_t length) {
+    size_t i = 0;
+    if (i < length && p[i] == '-') i++;
+    if (i == length || !dawn__is_digit(p[i])) return 0;
+    if (p[i] == '0') {
+        i++;
+    } else {
+        while (i < length && dawn__is_digit(p[i])) i++;
+    }
+    if (i < length && p[i] == '.') {
+        i++;
+        if (i == length || !dawn__is_digit(p[i])) return 0;
+        while (i < length && dawn__is_digit(p[i])) i++;
+    }
+    if (i < length && (p[i] | 0x20) == 'e') {
+        i++;
+        if (i < length && (p[i] == '+' || p[i] == '-')) i++;
+        if (i == length || !dawn__is_digit(p[i])) return 0;
+        while (i < length && dawn__is_digit(p[i])) i++;
+    }
+    return i;
+}
+
+// Length of the JSON string token at the start of p, including both quotes,
+// or 0 with *error set to the offset of the first invalid byte.
+static size_t dawn__json_string_length(const char *p, size_t length, bool *escaped, size_t *error) {
+    size_t i = 1;
+    for (;;) {
+        i = dawn__json_scan(p, length, i);
+        if (i == length || (unsigned char)p[i] < 0x20) break;
+        if (p[i] == '"') return i + 1;
+        *escaped = true;
+        if (i + 1 == length) break;
+        switch (p[i + 1]) {
+        case '"': case '\\': case '/': case 'b': case 'f': case 'n': case 'r': case 't':
+            i += 2;
+            continue;
+        case 'u':
+            if (length - i >= 6 && dawn__json_hex4(p + i + 2) >= 0) {
+                i += 6;
+                continue;
+            }
+            break;
+        }
+        break;
+    }
+    *error = i;
+    return 0;
+}
+
+DawnJsonToken dawn_json_next(DawnJsonTokenizer *tk) {
+    const char *data = tk->data;
+    size_t length = tk->length;
+    size_t i = tk->position;
+    DawnJsonToken token = {0};
+    if (tk->failed) {
+        token.kind = DAWN_JSON_ERROR;
+        token.text = dawn_sv_from_parts(data + i, i < length);
+        return token;
+    }
+
+    while (i < length && (data[i] == ' ' || data[i] == '\n' || data[i] == '\r' || data[i] == '\t')) i++;
+    if (i == length) {
+        tk->position = i;
+        token.kind = DAWN_JSON_END;
+        token.text = dawn_sv_from_parts(data + i, 0);
+        return token;
+    }
+
+    const char *p = data + i;
+    size_t rest = length - i;
+    size_t token_length = 1;
+    size_t error = 0;
+    switch (*p) {
+    case '{': token.kind = DAWN_JSON_OBJECT_BEGIN; break;
+    case '}': token.kind = DAWN_JSON_OBJECT_END; break;
+    case '[': token.kind = DAWN_JSON_ARRAY_BEGIN; break;
+    case ']': token.kind = DAWN_JSON_ARRAY_END; break;
+    case ':': token.kind = DAWN_JSON_COLON; break;
+    case ',': token.kind = DAWN_JSON_COMMA; break;
+    case '"':
+        token.kind = DAWN_JSON_STRING;
+        token_length = dawn__json_string_length(p, rest, &token.escaped, &error);
+        break;
+    case 't':
+        token.kind = DAWN_JSON_TRUE;
+        token_length = rest >= 4 && memcmp(p, "true", 4) == 0 ? 4 : 0;
+        break;
+    case 'f':
+        token.kind = DAWN_JSON_FALSE;
+        token_length = rest >= 5 && memcmp(p, "false", 5) == 0 ? 5 : 0;
+        break;
+    case 'n':
+        token.kind = DAWN_JSON_NULL;
+        token_length = rest >= 4 && memcmp(p, "null", 4) == 0 ? 4 : 0;
+        break;
+    default:
+        token.kind = DAWN_JSON_NUMBER;
+        token_length = dawn__json_number_length(p, rest);
+        break;
+    }
+    // Numbers and literals must end at a delimiter, so "01" or "nullnull"
+    // is an error rather than two tokens.
+    if (token.kind >= DAWN_JSON_NUMBER && token_length > 0 && token_length < rest) {
+        char c = p[token_length];
+        if (c != ' ' && c != '\n' && c != '\r' && c != '\t' && c != ',' && c != ':' && c != ']' && c != '}') {
+            error = token_length;
+            token_length = 0;
+        }
+    }
+
+    if (token_length == 0) {
+        tk->failed = true;
+        tk->position = i + error;
+        token.kind = DAWN_JSON_ERROR;
+        token.escaped = false;
+        token.text = dawn_sv_from_parts(data + tk->position, tk->position < length);
+        return token;
+    }
+    tk->position = i + token_length;
+    if (token.kind == DAWN_JSON_STRING) {
+        token.text = dawn_sv_from_parts(p + 1, token_length - 2);
+    } else {
+        token.text = dawn_sv_from_parts(p, token_length);
+    }
+    return token;
+}
+
+/*****
+ *CSV*
+ *****/
+
+static inline uint64_t dawn__prefix_xor(uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+// Bitmask of the separators outside quotes in the 64 bytes at p, of which only n are valid.
+static uint64_t dawn__csv_block(DawnCsvReader *reader, const char *p, size_t n) {
+    char padded[64];
+    if (n < 64) {
+        memset(padded, 0, sizeof padded);
+        memcpy(padded, p, n);
+        p = padded;
+    }
+    uint64_t quotes = 0;
+    uint64_t separators = 0;
+#if defined(DAWN_HAS_AVX2)
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i delimiter = _mm256_set1_epi8(reader->delimiter);
+    const __m256i newline = _mm256_set1_epi8('\n');
+    for (int k = 0; k < 2; k++) {
+        __m256i c = _mm256_loadu_si256((const __m256i *)(p + 32 * k));
+        quotes |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(c, quote)) << (32 * k);
+        separators |= (uint64_t)(uint32_t)_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(c, delimiter), _mm256_cmpeq_epi8(c, newline))) << (32 * k);
+    }
+#elif defined(DAWN_HAS_SSE2)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i delimiter = _mm_set1_epi8(reader->delimiter);
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (int k = 0; k < 4; k++) {
+        __m128i c = _mm_loadu_si128((const __m128i *)(p + 16 * k));
+        quotes |= (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(c, quote)) << (16 * k);
+        separators |= (uint64_t)(uint32_t)_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(c, delimiter), _mm_cmpeq_epi8(c, newline))) << (16 * k);
+    }
+#else
+    for (int k = 0; k < 64; k++) {
+        quotes |= (uint64_t)(p[k] == '"') << k;
+        separators |= (uint64_t)(p[k] == reader->delimiter || p[k] == '\n') << k;
+    }
+#endif
+    uint64_t inside = dawn__prefix_xor(quotes) ^ reader->inside_quotes;
+    reader->inside_quotes = (uint64_t)((int64_t)inside >> 63);
+    return separators & ~inside;
+}
+
+bool dawn_csv_next(DawnCsvReader *reader, DawnStringView *field, bool *end_of_record) {
+    while (reader->separators == 0) {
+        if (reader->scanned >= reader->length) {
+            // The last field runs to the end of the input, unless the input
+            // ended right after a newline.
+            if (reader->done || (reader->record_ended && reader->position == reader->length)) return false;
+            reader->done = true;
+            *field = dawn_sv_from_parts(reader->data + reader->position, reader->length - reader->position);
+            *end_of_record = true;
+            reader->position = reader->length;
+            return true;
+        }
+        size_t n = reader->length - reader->scanned;
+        reader->block_start = reader->scanned;
+        reader->separators = dawn__csv_block(reader, reader->data + reader->scanned, n < 64 ? n : 64);
+        reader->scanned += 64;
+    }
+
+    size_t end = reader->block_start + dawn__ctz64(reader->separators);
+    reader->separators &= reader->separators - 1;
+    size_t start = reader->position;
+    reader->position = end + 1;
+    reader->record_ended = reader->data[end] == '\n';
+    if (reader->record_ended && end > start && reader->data[end - 1] == '\r') end--;
+    *field = dawn_sv_from_parts(reader->data + start, end - start);
+    *end_of_record = reader->record_ended;
+    return true;
+}
+
+DawnStringView dawn_csv_unquote(DawnStringView field, DawnStringBuilder *scratch) {
+    if (field.length == 0 || field.data[0] != '"') return field;
+    size_t end = field.length > 1 && field.data[field.length - 1] == '"' ? field.length - 1 : field.length;
+    DawnStringView inner = dawn_sv_from_parts(field.data + 1, end - 1);
+    const char *quote = memchr(inner.data, '"', inner.length);
+    if (!quote) return inner;
+
+    scratch->length = 0;
+    DAWN_DA_RESERVE(scratch, inner.length);
+    const char *p = inner.data;
+    const char *inner_end = inner.data + inner.length;
+    while (quote) {
+        size_t run = (size_t)(quote - p) + 1;
+        memcpy(scratch->items + scratch->length, p, run);
+        scratch->length += run;
+        p = quote + 1;
+        if (p < inner_end && *p == '"') p++;
+        quote = memchr(p, '"', (size_t)(inner_end - p));
+    }
+    memcpy(scratch->items + scratch->length, p, (size_t)(inner_end - p));
+    scratch->length += (size_t)(inner_end - p);
+    return dawn_sv_from_sb(scratch);
+}
+
+static size_t dawn__count_byte(const char *p, size_t length, char byte) {
+    size_t count = 0;
+    size_t i = 0;
+#if defined(DAWN_HAS_AVX2)
+    const __m256i target = _mm256_set1_epi8(byte);
+    for (; i + 32 <= length; i += 32) {
+        __m256i c = _mm256_loadu_si256((const __m256i *)(p + i));
+        count += dawn__popcount64((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(c, target)));
+    }
+#elif defined(DAWN_HAS_SSE2)
+    const __m128i target = _mm_set1_epi8(byte);
+    for (; i + 16 <= length; i += 16) {
+        __m128i c = _mm_loadu_si128((const __m128i *)(p + i));
+        count += dawn__popcount64((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(c, target)));
+    }
+#endif
+    for (; i < length; i++) {
+        count += p[i] == byte;
+    }
+    return count;
+}
+
+size_t dawn_csv_split(const char *data, size_t length, size_t *starts, size_t count) {
+    assert(count > 0);
+    starts[0] = 0;
+    size_t chunks = 1;
+    size_t position = 0;
+    bool inside_quotes = false;
+    for (size_t k = 1; k < count; k++) {
+        size_t target = length / count * k;
+        if (target < position) continue;
+        inside_quotes ^= dawn__count_byte(data + position, target - position, '"') & 1;
+        position = target;
+        while (position < length) {
+            char c = data[position++];
+            if (c == '"') {
+                inside_quotes = !inside_quotes;
+            } else if (c == '\n' && !inside_quotes) {
+                break;
+            }
+        }
+        if (position >= length) break;
+        starts[chunks++] = position;
+    }
+    return chunks;
+}
+
+/*********
+ *Hashing*
+ *********/
+
+// Short inputs use wyhash (final version 4); long inputs accumulate 64 byte
+// stripes into eight 64-bit lanes in the style of XXH3, which maps directly
+// onto two AVX2 registers.
+
+#define DAWN__HASH_STRIPE 64
+#define DAWN__HASH_BLOCK_STRIPES 16
+
+static const uint64_t dawn__wyhash_secret[4] = {
+    0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull,
+};
+
+static const uint64_t dawn__hash_secret[24] = {
+    0x0544c9ab9e437c61ull, 0x5267b3359e70e125ull, 0x1024f4df769a4f31ull, 0x89beb47d6ddc7cd5ull,
+    0xef85234a68c93677ull, 0x430d12bf8a66b679ull, 0x529c49ed3e29514full, 0x82ec2188bffbb7e1ull,
+    0xea5b01e501a3af17ull, 0x27b7634899af97d7ull, 0x7dcfe58f92482a05ull, 0xef9f2150bd87adf3ull,
+    0x441cb3a861e345fbull, 0x75944df62eabf213ull, 0xf59311d3077f2f9full, 0x78e82f41ec30b773ull,
+    0xd95074f1581ff33dull, 0x7caa50d5c49fb74bull, 0x185087794a1fe23bull, 0xb472573f5102d487ull,
+    0xcf87fb994fc2dfbfull, 0xf9e081ad16b2aa3full, 0xfc8be43ebfb01bafull, 0x88bd34abfa48db27ull,
+};
+
+static inline uint64_t dawn__hash_mix(uint64_t a, uint64_t b) {
+    uint64_t hi;
+    uint64_t lo = dawn__mul128(a, b, &hi);
+    return lo ^ hi;
+}
+
+static uint64_t dawn__hash_short(const unsigned char *p, size_t length, uint64_t seed) {
+    const uint64_t *s = dawn__wyhash_secret;
+    uint64_t a, b;
+    seed ^= dawn__hash_mix(seed ^ s[0], s[1]);
+    if (length <= 16) {
+        if (length >= 4) {
+            size_t mid = (length >> 3) << 2;
+            a = (dawn__read32(p) << 32) | dawn__read32(p + mid);
+            b = (dawn__read32(p + length - 4) << 32) | dawn__read32(p + length - 4 - mid);
+        } else if (length > 0) {
+            a = ((uint64_t)p[0] << 16) | ((uint64_t)p[length >> 1] << 8) | p[length - 1];
+            b = 0;
+        } else {
+            a = b = 0;
+        }
+    } else {
+        size_t i = length;
+        if (i > 48) {
+            uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = dawn__hash_mix(dawn__read64(p) ^ s[1], dawn__read64(p + 8) ^ seed);
+                see1 = dawn__hash_mix(dawn__read64(p + 16) ^ s[2], dawn__read64(p + 24) ^ see1);
+                see2 = dawn__hash_mix(dawn__read64(p + 32) ^ s[3], dawn__read64(p + 40) ^ see2);
+                p += 48;
+                i -= 48;
+            } while (i > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (i > 16) {
+            seed = dawn__hash_mix(dawn__read64(p) ^ s[1], dawn__read64(p + 8) ^ seed);
+            i -= 16;
+            p += 16;
+        }
+        a = dawn__read64(p + i - 16);
+        b = dawn__read64(p + i - 8);
+    }
+    a ^= s[1];
+    b ^= seed;
+    a = dawn__mul128(a, b, &b);
+    return dawn__hash_mix(a ^ s[0] ^ length, b ^ s[1]);
+}
+
+static void dawn__hash_init_long(uint64_t acc[8], uint64_t secret[24], uint64_t seed) {
+    static const uint64_t init[8] = {
+        0x00000000C2B2AE3Dull, 0x9E3779B185EBCA87ull, 0xC2B2AE3D27D4EB4Full, 0x165667B19E3779F9ull,
+        0x85EBCA77C2B2AE63ull, 0x0000000085EBCA77ull, 0x27D4EB2F165667C5ull, 0x000000009E3779B1ull,
+    };
+    memcpy(acc, init, sizeof init);
+    for (size_t i = 0; i < 24; i++) {
+        secret[i] = dawn__hash_secret[i] + ((i & 1) ? 0 - seed : seed);
+    }
+}
+
+static inline void dawn__hash_accumulate(uint64_t acc[8], const unsigned char *p, const uint64_t *key) {
+    for (size_t i = 0; i < 8; i++) {
+        uint64_t data = dawn__read64(p + 8 * i);
+        uint64_t keyed = data ^ key[i];
+        acc[i ^ 1] += data;
+        acc[i] += (keyed & 0xFFFFFFFF) * (keyed >> 32);
+    }
+}
+
+// Accumulates count stripes, scrambling the lanes after every block of
+// DAWN__HASH_BLOCK_STRIPES. The position within the block is kept in *stripe
+// so that a streaming hasher can resume at any stripe boundary.
+static void dawn__hash_stripes(uint64_t acc[8], const unsigned char *p, size_t count,
+                               const uint64_t secret[24], size_t *stripe) {
+#ifdef DAWN_HAS_AVX2
+    __m256i acc0 = _mm256_loadu_si256((const __m256i *)acc);
+    __m256i acc1 = _mm256_loadu_si256((const __m256i *)(acc + 4));
+    const __m256i prime = _mm256_set1_epi64x(0x9E3779B1);
+    for (size_t n = 0; n < count; n++, p += DAWN__HASH_STRIPE) {
+        const uint64_t *key = secret + *stripe;
+        __m256i data0 = _mm256_loadu_si256((const __m256i *)p);
+        __m256i data1 = _mm256_loadu_si256((const __m256i *)(p + 32));
+        __m256i keyed0 = _mm256_xor_si256(data0, _mm256_loadu_si256((const __m256i *)key));
+        __m256i keyed1 = _mm256_xor_si256(data1, _mm256_loadu_si256((const __m256i *)(key + 4)));
+        acc0 = _mm256_add_epi64(acc0, _mm256_shuffle_epi32(data0, _MM_SHUFFLE(1, 0, 3, 2)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_shuffle_epi32(data1, _MM_SHUFFLE(1, 0, 3, 2)));
+        acc0 = _mm256_add_epi64(acc0, _mm256_mul_epu32(keyed0, _mm256_srli_epi64(keyed0, 32)));
+        acc1 = _mm256_add_epi64(acc1, _mm256_mul_epu32(keyed1, _mm256_srli_epi64(keyed1, 32)));
+
+        if (++*stripe == DAWN__HASH_BLOCK_STRIPES) {
+            *stripe = 0;
+            __m256i *accs[2] = {&acc0, &acc1};
+            for (size_t i = 0; i < 2; i++) {
+                __m256i a = *accs[i];
+                a = _mm256_xor_si256(a, _mm256_srli_epi64(a, 47));
+                a = _mm256_xor_si256(a, _mm256_loadu_si256((const __m256i *)(secret + 16 + 4 * i)));
+                __m256i lo = _mm256_mul_epu32(a, prime);
+                __m256i hi = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), prime);
+                *accs[i] = _mm256_add_epi64(lo, _mm256_slli_epi64(hi, 32));
+            }
+        }
+    }
+    _mm256_storeu_si256((__m256i *)acc, acc0);
+    _mm256_storeu_si256((__m256i *)(acc + 4), acc1);
+#else
+    for (size_t n = 0; n < count; n++, p += DAWN__HASH_STRIPE) {
+        dawn__hash_accumulate(acc, p, secret + *stripe);
+        if (++*stripe == DAWN__HASH_BLOCK_STRIPES) {
+            *stripe = 0;
+            for (size_t i = 0; i < 8; i++) {
+                uint64_t a = acc[i];
+                a ^= a >> 47;
+                a ^= secret[16 + i];
+                acc[i] = a * 0x9E3779B1;
+            }
+        }
+    }
+#endif
+}
+
+static uint64_t dawn__hash_merge(const uint64_t acc[8], const uint64_t secret[24], uint64_t length) {
+    uint64_t h = length * 0x9E3779B185EBCA87ull;
+    for (size_t i = 0; i < 4; i++) {
+        h += dawn__hash_mix(acc[2*i] ^ secret[11 + 2*i], acc[2*i + 1] ^ secret[12 + 2*i]);
+    }
+    h ^= h >> 37;
+    h *= 0x165667919E3779F9ull;
+    h ^= h >> 32;
+    return h;
+}
+
+uint64_t dawn_hash64(const void *buf, size_t length, uint64_t seed) {
+    const unsigned char *p = buf;
+    if (length <= DAWN_HASH_LONG_INPUT) return dawn__hash_short(p, length, seed);
+
+    uint64_t acc[8];
+    uint64_t secret[24];
+    size_t stripe = 0;
+    dawn__hash_init_long(acc, secret, seed);
+    // The last stripe is always the final 64 bytes, overlapping the previous
+    // one, so at least one byte is left for it.
+    dawn__hash_stripes(acc, p, (length - 1) / DAWN__HASH_STRIPE, secret, &stripe);
+    dawn__hash_accumulate(acc, p + length - DAWN__HASH_STRIPE, secret + 7);
+    return dawn__hash_merge(acc, secret, length);
+}
+
+void dawn_hasher_init(DawnHasher *hasher, uint64_t seed) {
+    hasher->seed = seed;
+    hasher->total_length = 0;
+    hasher->stripe = 0;
+    hasher->buffered = 0;
+    dawn__hash_init_long(hasher->acc, hasher->secret, seed);
+}
+
+void dawn_hasher_update(DawnHasher *hasher, const void *buf, size_t length) {
+    const unsigned char *p = buf;
+    const size_t buffer_stripes = DAWN_HASH_LONG_INPUT / DAWN__HASH_STRIPE;
+    hasher->total_length += length;
+
+    if (hasher->buffered + length <= DAWN_HASH_LONG_INPUT) {
+        if (length > 0) memcpy(hasher->buffer + hasher->buffered, p, length);
+        hasher->buffered += length;
+        return;
+    }
+
+    // More data follows whatever is consumed here, so none of it can be the last stripe.
+    if (hasher->buffered > 0) {
+        size_t fill = DAWN_HASH_LONG_INPUT - hasher->buffered;
+        memcpy(hasher->buffer + hasher->buffered, p, fill);
+        p += fill;
+        length -= fill;
+        dawn__hash_stripes(hasher->acc, hasher->buffer, buffer_stripes, hasher->secret, &hasher->stripe);
+        memcpy(hasher->last_stripe, hasher->buffer + DAWN_HASH_LONG_INPUT - DAWN__HASH_STRIPE, DAWN__HASH_STRIPE);
+        hasher->buffered = 0;
+    }
+
+    if (length > DAWN_HASH_LONG_INPUT) {
+        size_t blocks = (length - 1) / DAWN_HASH_LONG_INPUT;
+        dawn__hash_stripes(hasher->acc, p, blocks * buffer_stripes, hasher->secret, &hasher->stripe);
+        p += blocks * DAWN_HASH_LONG_INPUT;
+        length -= blocks * DAWN_HASH_LONG_INPUT;
+        memcpy(hasher->last_stripe, p - DAWN__HASH_STRIPE, DAWN__HASH_STRIPE);
+    }
+
+    memcpy(hasher->buffer, p, length);
+    hasher->buffered = length;
+}
+
+uint64_t dawn_hasher_digest(const DawnHasher *hasher) {
+    if (hasher->total_length <= DAWN_HASH_LONG_INPUT) {
+        return dawn__hash_short(hasher->buffer, hasher->buffered, hasher->seed);
+    }
+
+    uint64_t acc[8];
+    size_t stripe = hasher->stripe;
+    memcpy(acc, hasher->acc, sizeof acc);
+    dawn__hash_stripes(acc, hasher->buffer, (hasher->buffered - 1) / DAWN__HASH_STRIPE, hasher->secret, &stripe);
+
+    const unsigned char *last = hasher->buffer + hasher->buffered - DAWN__HASH_STRIPE;
+    unsigned char joined[DAWN__HASH_STRIPE];
+    if (hasher->buffered < DAWN__HASH_STRIPE) {
+        size_t carried = DAWN__HASH_STRIPE - hasher->buffered;
+        memcpy(joined, hasher->last_stripe + hasher->buffered, carried);
+        memcpy(joined + carried, hasher->buffer, hasher->buffered);
+        last = joined;
+    }
+    dawn__hash_accumulate(acc, last, hasher->secret + 7);
+    return dawn__hash_merge(acc, hasher->secret, hasher->total_length);
+}
+
+/**********
+ *Hash map*
+ **********/
+
+#define DAWN__HM_GROUP_WIDTH 16
+#define DAWN__HM_EMPTY   0x80
+#define DAWN__HM_DELETED 0xFE
+#define DAWN__HM_NOT_FOUND SIZE_MAX
+// Smaller key arenas are never compacted.
+#define DAWN__HM_MIN_COMPACT 256
+
+// Bitmask of the bytes in the 16 byte group g that equal b.
+static inline uint32_t dawn__hm_match(const uint8_t *g, uint8_t b) {
+#ifdef DAWN_HAS_SSE2
+    __m128i ctrl = _mm_loadu_si128((const __m128i *)g);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)b)));
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < DAWN__HM_GROUP_WIDTH; i++) {
+        mask |= (uint32_t)(g[i] == b) << i;
+    }
+    return mask;
+#endif
+}
+
+// Bitmask of the empty or deleted bytes in the group; both have the high bit set.
+static inline uint32_t dawn__hm_match_free(const uint8_t *g) {
+#ifdef DAWN_HAS_SSE2
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)g));
+#else
+    uint32_t mask = 0;
+    for (unsigned i = 0; i < DAWN__HM_GROUP_WIDTH; i++) {
+        mask |= (uint32_t)(g[i] >> 7) << i;
+    }
+    return mask;
+#endif
+}
+
+static inline size_t dawn__hm_align(size_t size) {
+    size_t align = size & (~size + 1);
+    return align == 0 || align > 16 ? 16 : align;
+}
+
+static inline size_t dawn__hm_value_offset(const DawnHashMap *hm) {
+    size_t align = dawn__hm_align(hm->value_size);
+    return (hm->key_size + align - 1) & ~(align - 1);
+}
+
+static inline size_t dawn__hm_stride(const DawnHashMap *hm) {
+    size_t align = dawn__hm_align(hm->key_size);
+    size_t value_align = dawn__hm_align(hm->value_size);
+    if (value_align > align) align = value_align;
+    size_t size = dawn__hm_value_offset(hm) + hm->value_size;
+    return (size + align - 1) & ~(align - 1);
+}
+
+static inline char *dawn__hm_slot(const DawnHashMap *hm, size_t index) {
+    return hm->items + index * dawn__hm_stride(hm);
+}
+
+static inline void dawn__hm_set_ctrl(DawnHashMap *hm, size_t index, uint8_t value) {
+    hm->ctrl[index] = value;
+    // The first group is mirrored past the end so that a group load never wraps.
+    if (index < DAWN__HM_GROUP_WIDTH) hm->ctrl[hm->capacity + index] = value;
+}
+
+static uint64_t dawn__hm_hash_slot(const DawnHashMap *hm, size_t index) {
+    const char *slot = dawn__hm_slot(hm, index);
+    if (hm->string_keys) {
+        const DawnHashMapStrKey *k = (const DawnHashMapStrKey *)slot;
+        return dawn_hash64(hm->key_arena.items + k->offset, k->length, 0);
+    }
+    return dawn_hash64(slot, hm->key_size, 0);
+}
+
+static inline bool dawn__hm_key_eq(const DawnHashMap *hm, size_t index, const void *key, size_t key_length) {
+    const char *slot = dawn__hm_slot(hm, index);
+    if (hm->string_keys) {
+        const DawnHashMapStrKey *k = (const DawnHashMapStrKey *)slot;
+        return k->length == key_length && memcmp(hm->key_arena.items + k->offset, key, key_length) == 0;
+    }
+    return memcmp(slot, key, hm->key_size) == 0;
+}
+
+static size_t dawn__hm_find(const DawnHashMap *hm, const void *key, size_t key_length, uint64_t hash) {
+    if (hm->capacity == 0) return DAWN__HM_NOT_FOUND;
+
+    size_t mask = hm->capacity - 1;
+    uint8_t h2 = hash & 0x7F;
+    size_t pos = (hash >> 7) & mask;
+    // Probing is linear over groups, so every slot between an entry's home
+    // and its actual position is occupied and the first empty slot ends the search.
+    for (size_t probed = 0; probed < hm->capacity; probed += DAWN__HM_GROUP_WIDTH) {
+        const uint8_t *g = hm->ctrl + pos;
+        for (uint32_t m = dawn__hm_match(g, h2); m; m &= m - 1) {
+            size_t index = (pos + dawn__ctz32(m)) & mask;
+            if (dawn__hm_key_eq(hm, index, key, key_length)) return index;
+        }
+        if (dawn__hm_match(g, DAWN__HM_EMPTY)) break;
+        pos = (pos + DAWN__HM_GROUP_WIDTH) & mask;
+    }
+    return DAWN__HM_NOT_FOUND;
+}
+
+static size_t dawn__hm_find_free(const DawnHashMap *hm, uint64_t hash) {
+    size_t mask = hm->capacity - 1;
+    size_t pos = (hash >> 7) & mask;
+    for (;;) {
+        uint32_t m = dawn__hm_match_free(hm->ctrl + pos);
+        if (m) return (pos + dawn__ctz32(m)) & mask;
+        pos = (pos + DAWN__HM_GROUP_WIDTH) & mask;
+    }
+}
+
+static void dawn__hm_rehash(DawnHashMap *hm, size_t new_capacity) {
+    size_t stride = dawn__hm_stride(hm);
+    size_t ctrl_size = (new_capacity + DAWN__HM_GROUP_WIDTH + 15) & ~(size_t)15;
+    uint8_t *block = malloc(ctrl_size + new_capacity * stride);
+    assert(block && "Not enough RAM for malloc");
+    memset(block, DAWN__HM_EMPTY, new_capacity + DAWN__HM_GROUP_WIDTH);
+
+    DawnHashMap old = *hm;
+    hm->ctrl = block;
+    hm->items = (char *)block + ctrl_size;
+    hm->capacity = new_capacity;
+    hm->tombstones = 0;
+
+    for (size_t i = 0; i < old.capacity; i++) {
+        if (old.ctrl[i] & 0x80) continue;
+        uint64_t hash = dawn__hm_hash_slot(&old, i);
+        size_t index = dawn__hm_find_free(hm, hash);
+        dawn__hm_set_ctrl(hm, index, hash & 0x7F);
+        memcpy(dawn__hm_slot(hm, index), dawn__hm_slot(&old, i), stride);
+    }
+    free(old.ctrl);
+}
+
+// Returns the slot for the key, claiming a fresh one if it is not present yet.
+static size_t dawn__hm_claim(DawnHashMap *hm, const void *key, size_t key_length, uint64_t hash, bool *inserted) {
+    size_t index = dawn__hm_find(hm, key, key_length, hash);
+    if (index != DAWN__HM_NOT_FOUND) {
+        *inserted = false;
+        return index;
+    }
+
+    // Keep the load, tombstones included, at or below 7/8.
+    if ((hm->length + hm->tombstones + 1) * 8 > hm->capacity * 7) {
+        size_t new_capacity = hm->capacity ? hm->capacity : DAWN__HM_GROUP_WIDTH;
+        while ((hm->length + 1) * 16 > new_capacity * 7) {
+            new_capacity *= 2;
+        }
+        dawn__hm_rehash(hm, new_capacity);
+    }
+
+    index = dawn__hm_find_free(hm, hash);
+    if (hm->ctrl[index] == DAWN__HM_DELETED) hm->tombstones--;
+    dawn__hm_set_ctrl(hm, index, hash & 0x7F);
+    hm->length++;
+    *inserted = true;
+    return index;
+}
+
+static void dawn__hm_erase(DawnHashMap *hm, size_t index) {
+    size_t mask = hm->capacity - 1;
+    hm->length--;
+    if (hm->string_keys) hm->key_bytes -= ((const DawnHashMapStrKey *)dawn__hm_slot(hm, index))->length;
+
+    if (!hm->backward_shift) {
+        // No probe can run past index if the following slot is empty.
+        if (hm->ctrl[(index + 1) & mask] == DAWN__HM_EMPTY) {
+            dawn__hm_set_ctrl(hm, index, DAWN__HM_EMPTY);
+        } else {
+            dawn__hm_set_ctrl(hm, index, DAWN__HM_DELETED);
+            hm->tombstones++;
+        }
+        return;
+    }
+
+    size_t stride = dawn__hm_stride(hm);
+    size_t hole = index;
+    for (size_t j = (index + 1) & mask; hm->ctrl[j] != DAWN__HM_EMPTY; j = (j + 1) & mask) {
+        size_t home = (dawn__hm_hash_slot(hm, j) >> 7) & mask;
+        // Move the entry back unless its home lies in (hole, j].
+        if (((j - home) & mask) >= ((j - hole) & mask)) {
+            dawn__hm_set_ctrl(hm, hole, hm->ctrl[j]);
+            memcpy(dawn__hm_slot(hm, hole), dawn__hm_slot(hm, j), stride);
+            hole = j;
+        }
+    }
+    dawn__hm_set_ctrl(hm, hole, DAWN__HM_EMPTY);
+}
+
+// Copies the live keys into a fresh arena and rewrites their offsets.
+// Returns the old arena, which the caller frees.
+static char *dawn__hm_compact_keys(DawnHashMap *hm) {
+    DawnStringBuilder arena = {0, 0, NULL};
+    DAWN_DA_RESERVE(&arena, hm->key_bytes);
+    for (size_t i = dawn_hm_next(hm, 0); i < hm->capacity; i = dawn_hm_next(hm, i + 1)) {
+        DawnHashMapStrKey *k = (DawnHashMapStrKey *)dawn__hm_slot(hm, i);
+        size_t offset = arena.length;
+        DAWN_SB_APPEND_BUF(&arena, hm->key_arena.items + k->offset, k->length);
+        k->offset = offset;
+    }
+    char *old = hm->key_arena.items;
+    hm->key_arena = arena;
+    return old;
+}
+
+static void dawn__hm_store_str_key(DawnHashMap *hm, size_t index, const char *key, size_t key_length) {
+    DawnHashMapStrKey *k = (DawnHashMapStrKey *)dawn__hm_slot(hm, index);
+    // The slot was just claimed, so give it an empty key before a compaction walks it.
+    k->offset = 0;
+    k->length = 0;
+    // Removed keys are only dropped here rather than in dawn__hm_rehash, since
+    // a backward-shifting map never rehashes under churn. The arena is kept
+    // alive until the copy because the key may point into it.
+    char *old_arena = NULL;
+    if (hm->key_arena.length > DAWN__HM_MIN_COMPACT && hm->key_arena.length > 2 * (hm->key_bytes + key_length)) {
+        const char *arena = hm->key_arena.items;
+        bool aliased = key >= arena && key < arena + hm->key_arena.length;
+        old_arena = dawn__hm_compact_keys(hm);
+        if (!aliased) {
+            free(old_arena);
+            old_arena = NULL;
+        }
+    }
+
+    k->offset = hm->key_arena.length;
+    k->length = key_length;
+    hm->key_bytes += key_length;
+    // The key may point into the arena itself, which the growth can move.
+    size_t key_offset = SIZE_MAX;
+    const char *arena = hm->key_arena.items;
+    if (arena && key >= arena && key < arena + hm->key_arena.length) key_offset = key - arena;
+    DAWN_DA_RESERVE(&hm->key_arena, key_length);
+    if (key_offset != SIZE_MAX) key = hm->key_arena.items + key_offset;
+    DAWN_SB_APPEND_BUF(&hm->key_arena, key, key_length);
+    free(old_arena);
+}
+
+void *dawn_hm_get(const DawnHashMap *hm, const void *key) {
+    assert(!hm->string_keys);
+    uint64_t hash = dawn_hash64(key, hm->key_size, 0);
+    size_t index = dawn__hm_find(hm, key, hm->key_size, hash);
+    if (index == DAWN__HM_NOT_FOUND) return NULL;
+    return dawn_hm_value_at(hm, index);
+}
+
+void *dawn_hm_put(DawnHashMap *hm, const void *key, const void *value) {
+    assert(!hm->string_keys);
+    uint64_t hash = dawn_hash64(key, hm->key_size, 0);
+    bool inserted;
+    size_t index = dawn__hm_claim(hm, key, hm->key_size, hash, &inserted);
+    if (inserted) memcpy(dawn__hm_slot(hm, index), key, hm->key_size);
+
+    void *slot_value = dawn_hm_value_at(hm, index);
+    if (value) {
+        memcpy(slot_value, value, hm->value_size);
+    } else if (inserted) {
+        memset(slot_value, 0, hm->value_size);
+    }
+    return slot_value;
+}
+
+bool dawn_hm_remove(DawnHashMap *hm, const void *key) {
+    assert(!hm->string_keys);
+    uint64_t hash = dawn_hash64(key, hm->key_size, 0);
+    size_t index = dawn__hm_find(hm, key, hm->key_size, hash);
+    if (index == DAWN__HM_NOT_FOUND) return false;
+    dawn__hm_erase(hm, index);
+    return true;
+}
+
+void *dawn_hm_get_str(const DawnHashMap *hm, const char *key, size_t key_length) {
+    assert(hm->string_keys);
+    uint64_t hash = dawn_hash64(key, key_length, 0);
+    size_t index = dawn__hm_find(hm, key, key_length, hash);
+    if (index == DAWN__HM_NOT_FOUND) return NULL;
+    return dawn_hm_value_at(hm, index);
+}
+
+void *dawn_hm_put_str(DawnHashMap *hm, const char *key, size_t key_length, const void *value) {
+    assert(hm->string_keys);
+    uint64_t hash = dawn_hash64(key, key_length, 0);
+    bool inserted;
+    size_t index = dawn__hm_claim(hm, key, key_length, hash, &inserted);
+    if (inserted) dawn__hm_store_str_key(hm, index, key, key_length);
+
+    void *slot_value = dawn_hm_value_at(hm, index);
+    if (value) {
+        memcpy(slot_value, value, hm->value_size);
+    } else if (inserted) {
+        memset(slot_value, 0, hm->value_size);
+    }
+    return slot_value;
+}
+
+bool dawn_hm_remove_str(DawnHashMap *hm, const char *key, size_t key_length) {
+    assert(hm->string_keys);
+    uint64_t hash = dawn_hash64(key, key_length, 0);
+    size_t index = dawn__hm_find(hm, key, key_length, hash);
+    if (index == DAWN__HM_NOT_FOUND) return false;
+    dawn__hm_erase(hm, index);
+    return true;
+}
+
+void dawn_hm_reserve(DawnHashMap *hm, size_t count) {
+    size_t new_capacity = hm->capacity ? hm->capacity : DAWN__HM_GROUP_WIDTH;
+    while (count * 8 > new_capacity * 7) {
+        new_capacity *= 2;
+    }
+    if (new_capacity != hm->capacity) dawn__hm_rehash(hm, new_capacity);
+}
+
+size_t dawn_hm_next(const DawnHashMap *hm, size_t index) {
+    while (index < hm->capacity && (hm->ctrl[index] & 0x80)) {
+        index++;
+    }
+    return index < hm->capacity ? index : hm->capacity;
+}
+
+void *dawn_hm_key_at(const DawnHashMap *hm, size_t index) {
+    assert(!hm->string_keys);
+    return dawn__hm_slot(hm, index);
+}
+
+const char *dawn_hm_str_key_at(const DawnHashMap *hm, size_t index, size_t *key_length) {
+    assert(hm->string_keys);
+    const DawnHashMapStrKey *k = (const DawnHashMapStrKey *)dawn__hm_slot(hm, index);
+    if (key_length) *key_length = k->length;
+    return hm->key_arena.items + k->offset;
+}
+
+void *dawn_hm_value_at(const DawnHashMap *hm, size_t index) {
+    return dawn__hm_slot(hm, index) + dawn__hm_value_offset(hm);
+}
+
+/**********
+ *Interner*
+ **********/
+
+uint32_t dawn_intern(DawnInterner *in, const char *str, size_t length) {
+    uint64_t hash = dawn_hash64(str, length, 0);
+    bool inserted;
+    size_t index = dawn__hm_claim(&in->ids, str, length, hash, &inserted);
+    uint32_t *id = dawn_hm_value_at(&in->ids, index);
+    if (inserted) {
+        assert(in->length < UINT32_MAX && "Too many interned strings");
+        dawn__hm_store_str_key(&in->ids, index, str, length);
+        *id = (uint32_t)in->length;
+        DAWN_DA_APPEND(in, *(DawnHashMapStrKey *)dawn__hm_slot(&in->ids, index));
+    }
+    return *id;
+}
+
+bool dawn_intern_lookup(const DawnInterner *in, const char *str, size_t length, uint32_t *id) {
+    uint32_t *found = dawn_hm_get_str(&in->ids, str, length);
+    if (!found) return false;
+    if (id) *id = *found;
+    return true;
+}
+
+const char *dawn_interner_get(const DawnInterner *in, uint32_t id, size_t *length) {
+    assert(id < in->length);
+    if (length) *length = in->items[id].length;
+    return in->ids.key_arena.items + in->items[id].offset;
+}
+
+/******
+ *Rope*
+ ******/
+
+#define DAWN__ROPE_LEAF_MAX 1024
+
+// Leaves have no children and keep their bytes in text, which points just
+// past the node in the same allocation; inner nodes only cache the totals
+// of their children.
+struct DawnRopeNode {
+    DawnRopeNode *left;
+    DawnRopeNode *right;
+    char *text;
+    size_t length;
+    size_t newlines;
+    int height;
+};
+
+static inline bool dawn__rope_is_leaf(const DawnRopeNode *node) {
+    return node->left == NULL;
+}
+
+static inline int dawn__rope_height(const DawnRopeNode *node) {
+    return node ? node->height : 0;
+}
+
+static DawnRopeNode *dawn__rope_leaf(const char *str, size_t length) {
+    assert(length <= DAWN__ROPE_LEAF_MAX);
+    DawnRopeNode *node = malloc(sizeof *node + DAWN__ROPE_LEAF_MAX);
+    assert(node && "Not enough RAM for malloc");
+    node->left = NULL;
+    node->right = NULL;
+    node->text = (char *)(node + 1);
+    node->length = length;
+    node->newlines = dawn__count_byte(str, length, '\n');
+    node->height = 1;
+    memcpy(node->text, str, length);
+    return node;
+}
+
+static void dawn__rope_update(DawnRopeNode *node) {
+    node->length = node->left->length + node->right->length;
+    node->newlines = node->left->newlines + node->right->newlines;
+    int left_height = node->left->height;
+    int right_height = node->right->height;
+    node->height = 1 + (left_height > right_height ? left_height : right_height);
+}
+
+static DawnRopeNode *dawn__rope_inner(DawnRopeNode *left, DawnRopeNode *right) {
+    DawnRopeNode *node = malloc(sizeof *node);
+    assert(node && "Not enough RAM for malloc");
+    node->left = left;
+    node->right = right;
+    node->text = NULL;
+    dawn__rope_update(node);
+    return node;
+}
+
+static DawnRopeNode *dawn__rope_rotate_left(DawnRopeNode *node) {
+    DawnRopeNode *right = node->right;
+    node->right = right->left;
+    dawn__rope_update(node);
+    right->left = node;
+    dawn__rope_update(right);
+    return right;
+}
+
+static DawnRopeNode *dawn__rope_rotate_right(DawnRopeNode *node) {
+    DawnRopeNode *left = node->left;
+    node->left = left->right;
+    dawn__rope_update(node);
+    left->right = node;
+    dawn__rope_update(left);
+    return left;
+}
+
+static DawnRopeNode *dawn__rope_rebalance(DawnRopeNode *node) {
+    dawn__rope_update(node);
+    int balance = node->left->height - node->right->height;
+    if (balance > 1) {
+        if (dawn__rope_height(node->left->left) < dawn__rope_height(node->left->right)) {
+            node->left = dawn__rope_rotate_left(node->left);
+        }
+        return dawn__rope_rotate_right(node);
+    }
+    if (balance < -1) {
+        if (dawn__rope_height(node->right->right) < dawn__rope_height(node->right->left)) {
+            node->right = dawn__rope_rotate_right(node->right);
+        }
+        return dawn__rope_rotate_left(node);
+    }
+    return node;
+}
+
+// AVL join: descends the spine of the taller tree until the heights match,
+// merging the two leaves at the seam when they fit into one.
+static DawnRopeNode *dawn__rope_join(DawnRopeNode *left, DawnRopeNode *right) {
+    if (!left) return right;
+    if (!right) return left;
+    if (dawn__rope_is_leaf(left) && dawn__rope_is_leaf(right) &&
+        left->length + right->length <= DAWN__ROPE_LEAF_MAX) {
+        memcpy(left->text + left->length, right->text, right->length);
+        left->length += right->length;
+        left->newlines += right->newlines;
+        free(right);
+        return left;
+    }
+    if (left->height > right->height + 1) {
+        left->right = dawn__rope_join(left->right, right);
+        return dawn__rope_rebalance(left);
+    }
+    if (right->height > left->height + 1) {
+        right->left = dawn__rope_join(left, right->left);
+        return dawn__rope_rebalance(right);
+    }
+    return dawn__rope_inner(left, right);
+}
+
+// Splits node into the first index bytes, which are returned, and the rest.
+static DawnRopeNode *dawn__rope_split(DawnRopeNode *node, size_t index, DawnRopeNode **rest) {
+    if (!node || index == 0) {
+        *rest = node;
+        return NULL;
+    }
+    if (index >= node->length) {
+        *rest = NULL;
+        return node;
+    }
+    if (dawn__rope_is_leaf(node)) {
+        *rest = dawn__rope_leaf(node->text + index, node->length - index);
+        node->length = index;
+        node->newlines -= (*rest)->newlines;
+        return node;
+    }
+    DawnRopeNode *left = node->left;
+    DawnRopeNode *right = node->right;
+    free(node);
+    if (index <= left->length) {
+        DawnRopeNode *left_rest;
+        DawnRopeNode *head = dawn__rope_split(left, index, &left_rest);
+        *rest = dawn__rope_join(left_rest, right);
+        return head;
+    }
+    DawnRopeNode *head = dawn__rope_split(right, index - left->length, rest);
+    return dawn__rope_join(left, head);
+}
+
+static DawnRopeNode *dawn__rope_build(const char *str, size_t length) {
+    if (length <= DAWN__ROPE_LEAF_MAX) return dawn__rope_leaf(str, length);
+    size_t leaves = (length + DAWN__ROPE_LEAF_MAX - 1) / DAWN__ROPE_LEAF_MAX;
+    size_t half = leaves / 2 * DAWN__ROPE_LEAF_MAX;
+    return dawn__rope_inner(dawn__rope_build(str, half), dawn__rope_build(str + half, length - half));
+}
+
+static void dawn__rope_free_node(DawnRopeNode *node) {
+    if (!node) return;
+    if (!dawn__rope_is_leaf(node)) {
+        dawn__rope_free_node(node->left);
+        dawn__rope_free_node(node->right);
+    }
+    free(node);
+}
+
+// Edits a single leaf in place when the change fits into it, updating the
+// cached totals on the way back up. Returns false if the tree must be split.
+static bool dawn__rope_insert_in_leaf(DawnRopeNode *node, size_t index, const char *str, size_t length, size_t newlines) {
+    if (dawn__rope_is_leaf(node)) {
+        if (node->length + length > DAWN__ROPE_LEAF_MAX) return false;
+        memmove(node->text + index + length, node->text + index, node->length - index);
+        memcpy(node->text + index, str, length);
+    } else if (index <= node->left->length) {
+        if (!dawn__rope_insert_in_leaf(node->left, index, str, length, newlines)) return false;
+    } else {
+        if (!dawn__rope_insert_in_leaf(node->right, index - node->left->length, str, length, newlines)) return false;
+    }
+    node->length += length;
+    node->newlines += newlines;
+    return true;
+}
+
+static bool dawn__rope_delete_in_leaf(DawnRopeNode *node, size_t index, size_t length, size_t *newlines) {
+    if (dawn__rope_is_leaf(node)) {
+        if (index + length > node->length || length == node->length) return false;
+        *newlines = dawn__count_byte(node->text + index, length, '\n');
+        memmove(node->text + index, node->text + index + length, node->length - index - length);
+    } else if (index < node->left->length) {
+        if (!dawn__rope_delete_in_leaf(node->left, index, length, newlines)) return false;
+    } else {
+        if (!dawn__rope_delete_in_leaf(node->right, index - node->left->length, length, newlines)) return false;
+    }
+    node->length -= length;
+    node->newlines -= *newlines;
+    return true;
+}
+
+void dawn_rope_free(DawnRope *rope) {
+    dawn__rope_free_node(rope->root);
+    rope->root = NULL;
+}
+
+size_t dawn_rope_length(const DawnRope *rope) {
+    return rope->root ? rope->root->length : 0;
+}
+
+size_t dawn_rope_line_count(const DawnRope *rope) {
+    return (rope->root ? rope->root->newlines : 0) + 1;
+}
+
+void dawn_rope_insert(DawnRope *rope, size_t index, const char *str, size_t length) {
+    assert(index <= dawn_rope_length(rope));
+    if (length == 0) return;
+    if (rope->root &&
+        dawn__rope_insert_in_leaf(rope->root, index, str, length, dawn__count_byte(str, length, '\n'))) {
+        return;
+    }
+    DawnRopeNode *rest;
+    DawnRopeNode *head = dawn__rope_split(rope->root, index, &rest);
+    rope->root = dawn__rope_join(dawn__rope_join(head, dawn__rope_build(str, length)), rest);
+}
+
+void dawn_rope_delete(DawnRope *rope, size_t index, size_t length) {
+    size_t rope_length = dawn_rope_length(rope);
+    if (index >= rope_length) return;
+    if (length > rope_length - index) length = rope_length - index;
+    if (length == 0) return;
+    size_t newlines;
+    if (dawn__rope_delete_in_leaf(rope->root, index, length, &newlines)) return;
+    DawnRopeNode *rest;
+    DawnRopeNode *tail;
+    DawnRopeNode *head = dawn__rope_split(rope->root, index, &rest);
+    DawnRopeNode *deleted = dawn__rope_split(rest, length, &tail);
+    dawn__rope_free_node(deleted);
+    rope->root = dawn__rope_join(head, tail);
+}
+
+char dawn_rope_at(const DawnRope *rope, size_t index) {
+    assert(index < dawn_rope_length(rope));
+    const DawnRopeNode *node = rope->root;
+    while (!dawn__rope_is_leaf(node)) {
+        if (index < node->left->length) {
+            node = node->left;
+        } else {
+            index -= node->left->length;
+            node = node->right;
+        }
+    }
+    return node->text[index];
+}
+
+size_t dawn_rope_line_start(const DawnRope *rope, size_t line) {
+    if (line == 0) return 0;
+    if (line >= dawn_rope_line_count(rope)) return DAWN_NOT_FOUND;
+    // Find the line-th newline.
+    const DawnRopeNode *node = rope->root;
+    size_t offset = 0;
+    while (!dawn__rope_is_leaf(node)) {
+        if (line <= node->left->newlines) {
+            node = node->left;
+        } else {
+            line -= node->left->newlines;
+            offset += node->left->length;
+            node = node->right;
+        }
+    }
+    const char *p = node->text;
+    for (;;) {
+        p = memchr(p, '\n', node->length - (size_t)(p - node->text));
+        if (--line == 0) break;
+        p++;
+    }
+    return offset + (size_t)(p - node->text) + 1;
+}
+
+size_t dawn_rope_line_at(const DawnRope *rope, size_t index) {
+    assert(index <= dawn_rope_length(rope));
+    if (!rope->root) return 0;
+    const DawnRopeNode *node = rope->root;
+    size_t line = 0;
+    while (!dawn__rope_is_leaf(node)) {
+        if (index < node->left->length) {
+            node = node->left;
+        } else {
+            index -= node->left->length;
+            line += node->left->newlines;
+            node = node->right;
+        }
+    }
+    return line + dawn__count_byte(node->text, index, '\n');
+}
+
+static void dawn__rope_append(DawnStringBuilder *sb, const DawnRopeNode *node, size_t index, size_t length) {
+    if (dawn__rope_is_leaf(node)) {
+        DAWN_SB_APPEND_BUF(sb, node->text + index, length);
+        return;
+    }
+    size_t left_length = node->left->length;
+    if (index < left_length) {
+        size_t n = left_length - index < length ? left_length - index : length;
+        dawn__rope_append(sb, node->left, index, n);
+        length -= n;
+        index = left_length;
+    }
+    if (length > 0) dawn__rope_append(sb, node->right, index - left_length, length);
+}
+
+void dawn_sb_append_rope(DawnStringBuilder *sb, const DawnRope *rope, size_t index, size_t length) {
+    size_t rope_length = dawn_rope_length(rope);
+    if (index >= rope_length) return;
+    if (length > rope_length - index) length = rope_length - index;
+    DAWN_DA_RESERVE(sb, length);
+    if (length > 0) dawn__rope_append(sb, rope->root, index, length);
+}
+
+#ifdef DAWN__HAS_WRITEV
+#define DAWN__ROPE_IOV_BATCH 64
+
+typedef struct {
+    int fd;
+    int count;
+    struct iovec iov[DAWN__ROPE_IOV_BATCH];
+} Dawn__RopeWriter;
+
+static bool dawn__rope_flush(Dawn__RopeWriter *writer) {
+    struct iovec *iov = writer->iov;
+    int count = writer->count;
+    writer->count = 0;
+    while (count > 0) {
+        ssize_t written = writev(writer->fd, iov, count);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        // Skip what was written; a short write may end inside a chunk.
+        while (count > 0 && (size_t)written >= iov->iov_len) {
+            written -= (ssize_t)iov->iov_len;
+            iov++;
+            count--;
+        }
+        if (count > 0) {
+            iov->iov_base = (char *)iov->iov_base + written;
+            iov->iov_len -= (size_t)written;
+        }
+    }
+    return true;
+}
+
+static bool dawn__rope_gather(Dawn__RopeWriter *writer, const DawnRopeNode *node) {
+    if (!dawn__rope_is_leaf(node)) {
+        return dawn__rope_gather(writer, node->left) && dawn__rope_gather(writer, node->right);
+    }
+    if (writer->count == DAWN__ROPE_IOV_BATCH && !dawn__rope_flush(writer)) return false;
+    writer->iov[writer->count].iov_base = (void *)node->text;
+    writer->iov[writer->count].iov_len = node->length;
+    writer->count++;
+    return true;
+}
+
+bool dawn_rope_write_entire_file(const char *filepath, const DawnRope *rope) {
+    if (!filepath || !rope) return false;
+
+    bool result;
+
+    Dawn__RopeWriter writer = {0};
+    writer.fd = open(filepath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (writer.fd < 0) {
+        perror("Failed to open file!");
+        DAWN_DEFER_RETURN(false);
+    }
+
+    if (rope->root && !(dawn__rope_gather(&writer, rope->root) && dawn__rope_flush(&writer))) {
+        fprintf(stderr, "ERROR: There was an error when writing content to %s\n", filepath);
+        DAWN_DEFER_RETURN(false);
+    }
+
+    result = true;
+
+defer:
+    if (writer.fd >= 0) {
+        close(writer.fd);
+    }
+    return result;
+}
+#else
+static bool dawn__rope_fwrite(FILE *f, const DawnRopeNode *node) {
+    if (!dawn__rope_is_leaf(node)) {
+        return dawn__rope_fwrite(f, node->left) && dawn__rope_fwrite(f, node->right);
+    }
+    return fwrite(node->text, 1, node->length, f) == node->length;
+}
+
+bool dawn_rope_write_entire_file(const char *filepath, const DawnRope *rope) {
+    if (!filepath || !rope) return false;
+
+    bool result;
+
+    FILE *f = fopen(filepath, "wb");
+    if (!f) {
+        perror("Failed to open file!");
+        DAWN_DEFER_RETURN(false);
+    }
+
+    if (rope->root && !dawn__rope_fwrite(f, rope->root)) {
+        fprintf(stderr, "ERROR: There was an error when writing content to %s\n", filepath);
+        DAWN_DEFER_RETURN(false);
+    }
+
+    result = true;
+
+defer:
+    if (f) {
+        fclose(f);
+    }
+    return result;
+}
+#endif
+
+/************
+ *Gap buffer*
+ ************/
+
+void dawn_gb_move_cursor(DawnGapBuffer *gb, size_t index) {
+    assert(index <= gb->length);
+    size_t gap = gb->capacity - gb->length;
+    if (index < gb->cursor) {
+        memmove(gb->items + index + gap, gb->items + index, gb->cursor - index);
+    } else if (index > gb->cursor) {
+        memmove(gb->items + gb->cursor, gb->items + gb->cursor + gap, index - gb->cursor);
+    }
+    gb->cursor = index;
+}
+
+void dawn_gb_insert(DawnGapBuffer *gb, const char *str, size_t length) {
+    if (length == 0) return;
+    size_t old_capacity = gb->capacity;
+    DAWN_DA_RESERVE(gb, length);
+    if (gb->capacity != old_capacity) {
+        // realloc kept the text after the gap at the end of the old block.
+        size_t tail = gb->length - gb->cursor;
+        memmove(gb->items + gb->capacity - tail, gb->items + old_capacity - tail, tail);
+    }
+    memcpy(gb->items + gb->cursor, str, length);
+    gb->cursor += length;
+    gb->length += length;
+}
+
+void dawn_gb_delete_before(DawnGapBuffer *gb, size_t count) {
+    if (count > gb->cursor) count = gb->cursor;
+    gb->cursor -= count;
+    gb->length -= count;
+}
+
+void dawn_gb_delete_after(DawnGapBuffer *gb, size_t count) {
+    if (count > gb->length - gb->cursor) count = gb->length - gb->cursor;
+    gb->length -= count;
+}
+
+void dawn_sb_append_gap_buffer(DawnStringBuilder *sb, const DawnGapBuffer *gb) {
+    if (gb->length == 0) return;
+    DAWN_DA_RESERVE(sb, gb->length);
+    size_t tail = gb->length - gb->cursor;
+    memcpy(sb->items + sb->length, gb->items, gb->cursor);
+    memcpy(sb->items + sb->length + gb->cursor, gb->items + gb->capacity - tail, tail);
+    sb->length += gb->length;
+}
+
+DawnStringBuilder dawn_gb_into_sb(DawnGapBuffer *gb) {
+    dawn_gb_move_cursor(gb, gb->length);
+    DawnStringBuilder sb = {gb->length, gb->capacity, gb->items};
+    DawnGapBuffer empty = {0, 0, NULL, 0};
+    *gb = empty;
+    return sb;
+}
+
+DawnGapBuffer dawn_gb_from_sb(DawnStringBuilder *sb) {
+    DawnGapBuffer gb = {sb->length, sb->capacity, sb->items, sb->length};
+    DawnStringBuilder empty = {0, 0, NULL};
+    *sb = empty;
+    return gb;
+}
+
+/********
+ *Random*
+ ********/
+
+static inline uint64_t dawn__rotl64(uint64_t x, unsigned k) {
+    return (x << k) | (x >> ((64 - k) & 63));
+}
+
+static inline uint64_t dawn__splitmix64(uint64_t *x) {
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+#define DAWN__PCG64_MULTIPLIER_HI 0x2360ED051FC65DA4ull
+#define DAWN__PCG64_MULTIPLIER_LO 0x4385DF649FCCF645ull
+
+// state = state * multiplier + increment, in 128 bits.
+static inline void dawn__pcg64_step(uint64_t *state) {
+    uint64_t hi;
+    uint64_t lo = dawn__mul128(state[0], DAWN__PCG64_MULTIPLIER_LO, &hi);
+    hi += state[0] * DAWN__PCG64_MULTIPLIER_HI + state[1] * DAWN__PCG64_MULTIPLIER_LO;
+    state[0] = lo + state[2];
+    state[1] = hi + state[3] + (state[0] < lo);
+}
+
+void dawn_rng_seed(DawnRng *rng, DawnRngKind kind, uint64_t seed) {
+    rng->kind = kind;
+    for (int i = 0; i < 4; i++) {
+        rng->state[i] = dawn__splitmix64(&seed);
+    }
+    if (kind == DAWN_RNG_XOSHIRO256PP) {
+        // The all-zero state is a fixed point.
+        if ((rng->state[0] | rng->state[1] | rng->state[2] | rng->state[3]) == 0) rng->state[0] = 1;
+    } else {
+        // Seeded like pcg_setseq_128_srandom_r: the increment must be odd.
+        uint64_t initial_lo = rng->state[0];
+        uint64_t initial_hi = rng->state[1];
+        rng->state[3] = rng->state[3] << 1 | rng->state[2] >> 63;
+        rng->state[2] = rng->state[2] << 1 | 1;
+        rng->state[0] = 0;
+        rng->state[1] = 0;
+        dawn__pcg64_step(rng->state);
+        rng->state[0] += initial_lo;
+        rng->state[1] += initial_hi + (rng->state[0] < initial_lo);
+        dawn__pcg64_step(rng->state);
+    }
+}
+
+DawnRng *dawn_rng_default(void) {
+    static DAWN_THREAD_LOCAL DawnRng rng;
+    static DAWN_THREAD_LOCAL bool seeded;
+    if (!seeded) {
+        static uint64_t threads;
+#if defined(__GNUC__) || defined(__clang__)
+        uint64_t thread = __atomic_fetch_add(&threads, 1, __ATOMIC_RELAXED);
+#else
+        uint64_t thread = threads++;
+#endif
+        uint64_t seed = (uint64_t)time(NULL) ^ (uint64_t)clock() << 32 ^ (uint64_t)(uintptr_t)&rng;
+        seed ^= dawn__rotl64(thread * 0x9E3779B97F4A7C15ull, 17);
+        dawn_rng_seed(&rng, DAWN_RNG_XOSHIRO256PP, seed);
+        seeded = true;
+    }
+    return &rng;
+}
+
+uint64_t dawn_rng_u64(DawnRng *rng) {
+    uint64_t *s = rng->state;
+    if (rng->kind == DAWN_RNG_XOSHIRO256PP) {
+        uint64_t result = dawn__rotl64(s[0] + s[3], 23) + s[0];
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = dawn__rotl64(s[3], 45);
+        return result;
+    }
+    dawn__pcg64_step(s);
+    return dawn__rotl64(s[1] ^ s[0], (64 - (unsigned)(s[1] >> 58)) & 63);
+}
+
+float dawn_rng_float(DawnRng *rng) {
+    return (float)(dawn_rng_u64(rng) >> 40) * 0x1.0p-24f;
+}
+
+double dawn_rng_double(DawnRng *rng) {
+    return (double)(dawn_rng_u64(rng) >> 11) * 0x1.0p-53;
+}
+
+// Maps x to [0, n) by taking the high half of x * n. The low half tells
+// whether x fell into one of the 2^64 mod n values that must be rejected.
+static inline uint64_t dawn__bounded_from_bits(DawnRng *rng, uint64_t x, uint64_t n) {
+    uint64_t hi;
+    uint64_t lo = dawn__mul128(x, n, &hi);
+    if (lo < n) {
+        uint64_t threshold = (0 - n) % n;
+        while (lo < threshold) {
+            lo = dawn__mul128(dawn_rng_u64(rng), n, &hi);
+        }
+    }
+    return hi;
+}
+
+uint64_t dawn_rng_bounded(DawnRng *rng, uint64_t n) {
+    assert(n > 0);
+    return dawn__bounded_from_bits(rng, dawn_rng_u64(rng), n);
+}
+
+int64_t dawn_rng_range(DawnRng *rng, int64_t min, int64_t max) {
+    assert(min <= max);
+    uint64_t span = (uint64_t)max - (uint64_t)min + 1;
+    if (span == 0) return (int64_t)dawn_rng_u64(rng);
+    return (int64_t)((uint64_t)min + dawn_rng_bounded(rng, span));
+}
+
+// Ziggurats with 256 layers of equal area, after J. Doornik, "An Improved
+// Ziggurat Method to Generate Normal Random Samples", 2005. x[0] is the width
+// of the base layer including its tail, x[1] = R where the tail begins, and
+// layer i covers [0, x[i]) above height f[i] = f(x[i]), with x[256] = 0.
+#define DAWN__ZIGGURAT_NORMAL_R 3.6541528853610092
+#define DAWN__ZIGGURAT_EXP_R 7.6971174701310501
+
+static const double dawn__ziggurat_normal_x[257] = {
+    3.9107579595249167, 3.6541528853610092, 3.4492782985614316, 3.320244733839826,
+    3.2245750520478023, 3.1478892895180013, 3.0835261320021439, 3.0278377917695938,
+    2.9786032798818436, 2.9343668672088881, 2.8941210536134125, 2.857138730873225,
+    2.8228773968264433, 2.790921174001928, 2.760944005279987, 2.7326853590440123,
+    2.7059336561230634, 2.6805146432857461, 2.6562830375767441, 2.6331163936315836,
+    2.6109105184888244, 2.5895759867082875, 2.5690354526818444, 2.5492215503247837,
+    2.5300752321598545, 2.5115444416266945, 2.4935830412710467, 2.4761499396705231,
+    2.4592083743347048, 2.4427253182003641, 2.4266709849371466, 2.4110184139011195,
+    2.3957431197819274, 2.3808227951720857, 2.3662370567172908, 2.3519672273791445,
+    2.3379961487965284, 2.3243080188711325, 2.3108882506013719, 2.2977233489028634,
+    2.2848008027244919, 2.2721089902283818, 2.2596370951737876, 2.2473750329473892,
+    2.2353133849299209, 2.2234433400925102, 2.2117566428841604, 2.200245546611276,
+    2.1889027716263603, 2.1777214677402923, 2.1666951803543077, 2.1558178198767366,
+    2.145083634047888, 2.1344871828460161, 2.1240233156895227, 2.1136871506866526,
+    2.1034740557148766, 2.0933796311387916, 2.0833996939983042, 2.0735302635187427,
+    2.0637675478117319, 2.0541079316506519, 2.0445479652175313, 2.0350843537296188,
+    2.0257139478638542, 2.016433734906204, 2.0072408305605287, 1.9981324713584196,
+    1.9891060076174381, 1.9801588969004766, 1.9712886979336592, 1.962493064944363,
+    1.9537697423846467, 1.9451165600086784, 1.9365314282756947, 1.9280123340526658,
+    1.9195573365931882, 1.9111645637712535, 1.9028322085504297, 1.8945585256707052,
+    1.8863418285367834, 1.8781804862929965, 1.8700729210712674, 1.8620176053996749,
+    1.8540130597602025, 1.8460578502851861, 1.8381505865828072, 1.8302899196827576,
+    1.8224745400938864, 1.8147031759662833, 1.8069745913508215, 1.7992875845497207,
+    1.791640986552163, 1.7840336595494419, 1.7764644955245235, 1.7689324149112691,
+    1.7614363653189107, 1.753975320317672, 1.7465482782817228, 1.7391542612859121,
+    1.7317923140529636, 1.7244615029480455, 1.7171609150178238, 1.7098896570713025,
+    1.7026468547999238, 1.6954316519345622, 1.6882432094371962, 1.6810807047251746,
+    1.6739433309261256, 1.6668302961616661, 1.6597408228581831, 1.6526741470830566,
+    1.6456295179047831, 1.6386061967755485, 1.6316034569348743, 1.6246205828330356,
+    1.6176568695730162, 1.6107116223698308, 1.6037841560260953, 1.5968737944227889,
+    1.5899798700241916, 1.5831017233960301, 1.5762387027359073, 1.5693901634151246,
+    1.5625554675310458, 1.5557339834691772, 1.5489250854741743, 1.542128153229003,
+    1.5353425714415152, 1.5285677294377134, 1.5218030207609992, 1.5150478427767158,
+    1.5083015962813129, 1.501563685115465, 1.4948335157804951, 1.488110497057449,
+    1.4813940396281888, 1.4746835556978568, 1.4679784586180809, 1.4612781625102769,
+    1.4545820818884116, 1.4478896312805773, 1.4412002248487252, 1.4345132760058934,
+    1.4278281970302571, 1.4211443986753103, 1.4144612897754725, 1.4077782768464002,
+    1.4010947636792523, 1.3944101509281424, 1.3877238356899773, 1.3810352110758566,
+    1.3743436657731674, 1.3676485835974772, 1.3609493430332842, 1.354245316762636,
+    1.3475358711805883, 1.3408203658964051, 1.334098153219361, 1.3273685776279269,
+    1.3206309752210572, 1.3138846731502214, 1.307128989030732, 1.3003632303308381,
+    1.2935866937369487, 1.2867986644932445, 1.2799984157138189, 1.2731852076653574,
+    1.2663582870182304, 1.2595168860637151, 1.2526602218948981, 1.2457874955486281,
+    1.2388978911056883, 1.2319905747461368, 1.2250646937565315, 1.2181193754854824,
+    1.2111537262437, 1.2041668301443824, 1.1971577478794424, 1.1901255154266928,
+    1.1830691426826876, 1.1759876120154529, 1.1688798767308342, 1.1617448594456123,
+    1.1545814503599288, 1.1473885054208501, 1.1401648443681522, 1.132909248652535,
+    1.1256204592155346, 1.1182971741193461, 1.1109380460135769, 1.1035416794246411,
+    1.0961066278520228, 1.0886313906539813, 1.0811144097034053, 1.0735540657924376,
+    1.0659486747621238, 1.0582964833306765, 1.0505956645909313, 1.0428443131441505,
+    1.0350404398334425, 1.0271819660356476, 1.0192667174654859, 1.0112924174399973,
+    1.0032566795446747, 0.99515699963509263, 0.9869907470990642, 0.9787551552942263,
+    0.9704473110642261, 0.96206414322304223, 0.9536024098810878, 0.94505868446816721,
+    0.93642934028657687, 0.92771053340200182, 0.91889818364959241, 0.90998795349672035,
+    0.90097522446122358, 0.89185507073294346, 0.88262222958516745, 0.87327106808886257,
+    0.86379554555331084, 0.85418917100816583, 0.84444495490915594, 0.83455535408638426,
+    0.82451220875229425, 0.81430667013521751, 0.8039291169899736, 0.7933690588406257,
+    0.78261502330723554, 0.77165442422457053, 0.76047340643011063, 0.74905666201781795,
+    0.73738721143429831, 0.72544614091000248, 0.71321228519097879, 0.70066184110681806,
+    0.68776789279579165, 0.67449982283729704, 0.66082257424442303, 0.64669571489499733,
+    0.6320722363860648, 0.61689699000775522, 0.60110461775599644, 0.58461676610638347,
+    0.56733825705382324, 0.54915170232716992, 0.52990972066156317, 0.50942332960209724,
+    0.48744396613924196, 0.46363433679088872, 0.43751840220787891, 0.40838913461199949,
+    0.37512133287839028, 0.33573751921443695, 0.28617459179208804, 0.2152418959849064,
+    0.0,
+};
+
+static const double dawn__ziggurat_normal_f[257] = {
+    0.0004774677646093862, 0.0012602859304985956, 0.0026090727461021593, 0.0040379725933630236,
+    0.005522403299250986, 0.007050875471373216, 0.00861658276939872, 0.010214971439701459,
+    0.011842757857907879, 0.013497450601739867, 0.01517708830793531, 0.016880083152543142,
+    0.018605121275724622, 0.020351096230044483, 0.02211706270730882, 0.023902203305795823,
+    0.025705804008548817, 0.027527235669603013, 0.029365939758133255, 0.03122141719192019,
+    0.03309321945857846, 0.03498094146171602, 0.03688421568856722, 0.038802707404526064,
+    0.0407361106559409, 0.042684144916474424, 0.044646552251294463, 0.04662309490193038,
+    0.04861355321586854, 0.05061772386094778, 0.05263541827679219, 0.05466646132488892,
+    0.0567106901062029, 0.05876795292093374, 0.06083810834953988, 0.06292102443775814,
+    0.0650165779712429, 0.0671246538277885, 0.06924514439700676, 0.0713779490588904,
+    0.07352297371398132, 0.07568013035892711, 0.07784933670209605, 0.08003051581466307,
+    0.0822235958132029, 0.08442850957035347, 0.08664519445055807, 0.08887359206827589,
+    0.09111364806637376, 0.09336531191269101, 0.095628536713009, 0.09790327903886246,
+    0.10018949876881002, 0.10248715894193525, 0.10479622562248707, 0.1071166677746838,
+    0.1094484571468118, 0.11179156816383809, 0.11414597782783849, 0.11651166562561087,
+    0.11888861344291006, 0.1212768054847903, 0.12367622820159657, 0.1260868702201859,
+    0.12850872227999957, 0.13094177717364436, 0.13338602969166916, 0.13584147657125376,
+    0.13830811644855073, 0.1407859498144447, 0.14327497897351346, 0.14577520800599403,
+    0.14828664273257455, 0.15080929068184568, 0.15334316106026286, 0.1558882647244792,
+    0.15844461415592428, 0.161012223437511, 0.16359110823236558, 0.1661812857644819,
+    0.1687827748012113, 0.17139559563750575, 0.17401977008183855, 0.17665532144373478,
+    0.1793022745228475, 0.18196065559952238, 0.1846304924267991, 0.18731181422380005,
+    0.1900046516704648, 0.19270903690358893, 0.1954250035141341, 0.19815258654577494,
+    0.20089182249465645, 0.20364274931033471, 0.20640540639788052, 0.20917983462112485,
+    0.21196607630703004, 0.21476417525117344, 0.21757417672433102, 0.22039612748015178,
+    0.22323007576391726, 0.22607607132237997, 0.22893416541467998, 0.23180441082433836,
+    0.23468686187232965, 0.23758157443123773, 0.2404886059405001, 0.2434080154227499,
+    0.24633986350126344, 0.24928421241852802, 0.2522411260559417, 0.2552106699546614,
+    0.2581929113376186, 0.26118791913272055, 0.26419576399726047, 0.2672165183435608,
+    0.27025025636587496, 0.2732970540685766, 0.2763569892956678, 0.27943014176163744,
+    0.2825165930837071, 0.2856164268155012, 0.2887297284821823, 0.2918565856170946,
+    0.29499708779996126, 0.298151326696685, 0.3013193961008025, 0.3045013919766494,
+    0.30769741250429145, 0.3109075581262859, 0.3141319315963365, 0.3173706380299129,
+    0.3206237849569047, 0.3238914823763904, 0.32717384281360057, 0.33047098137916275,
+    0.33378301583071757, 0.3371100666370053, 0.34045225704452103, 0.34380971314684994,
+    0.34718256395679287, 0.35057094148140533, 0.35397498080007594, 0.3573948201457797,
+    0.3608306009896472, 0.3642824681290031, 0.36775056977903164, 0.37123505766823856,
+    0.3747360871378902, 0.3782538172456183, 0.3817884108733928, 0.3853400348400765,
+    0.388908860018788, 0.39249506145931484, 0.3960988185158316, 0.3997203149801965,
+    0.4033597392211138, 0.40701728432947265, 0.41069314827018755, 0.4143875340408904,
+    0.4181006498378475, 0.4218327092294953, 0.4255839313380213, 0.4293545410294408,
+    0.43314476911265165, 0.4369548525479849, 0.44078503466580327, 0.4446355653957386,
+    0.4485067015072023, 0.4523987068618478, 0.45631185267871566, 0.4602464178128421,
+    0.4642026890481735, 0.4681809614056928, 0.4721815384677294, 0.47620473271950514,
+    0.480250865909046, 0.48432026942668244, 0.4884132847054572, 0.49253026364386776,
+    0.49667156905248894, 0.5008375751261479, 0.5050286679434673, 0.509245245995747,
+    0.513487720747326, 0.5177565172297554, 0.5220520746723208, 0.5263748471716834,
+    0.530725304403661, 0.5351039323804565, 0.5395112342569509, 0.543947731190025,
+    0.5484139632552646, 0.5529104904258311, 0.5574378936187647, 0.5619967758145232,
+    0.5665877632561631, 0.5712115067352519, 0.5758686829723524, 0.5805599961007896,
+    0.5852861792633699, 0.5900479963328245, 0.594846243767986, 0.5996817526191239,
+    0.6045553906974664, 0.6094680649257721, 0.6144207238889126, 0.619414360605833,
+    0.6244500155470252, 0.6295287799248354, 0.6346517992876223, 0.6398202774530553,
+    0.645035480820821, 0.6502987431108154, 0.6556114705796959, 0.6609751477766618,
+    0.6663913439087488, 0.6718617198970807, 0.677388036218772, 0.6829721616449933,
+    0.6886160830046703, 0.6943219161261152, 0.7000919181365101, 0.7059285013327526,
+    0.7118342488782468, 0.7178119326307203, 0.7238645334686284, 0.7299952645614745,
+    0.7362075981268609, 0.7425052963401493, 0.748892447219155, 0.7553735065070942,
+    0.7619533468367934, 0.7686373157984843, 0.7754313049811852, 0.7823418326548004,
+    0.7893761435660225, 0.7965423304229569, 0.8038494831709622, 0.811307874312654,
+    0.8189291916037001, 0.8267268339462192, 0.8347162929868812, 0.8429156531122018,
+    0.8513462584586755, 0.860033621196329, 0.8690086880368544, 0.8783096558089146,
+    0.8879846607558305, 0.8980959218983404, 0.9087264400521277, 0.9199915050393436,
+    0.9320600759592268, 0.9451989534422957, 0.9598790918001021, 0.977101701267666,
+    1.0,
+};
+
+static const double dawn__ziggurat_exp_x[257] = {
+    8.697117470131051, 7.6971174701310501, 6.9410336293772126, 6.4783784938325697,
+    6.1441646657724727, 5.8821443157953999, 5.6664101674540337, 5.4828906275260625,
+    5.323090505754398, 5.1814872813015, 5.0542884899813041, 4.9387770859012505,
+    4.832939741025112, 4.7352429966017411, 4.6444918854200852, 4.5597370617073514,
+    4.4802117465284219, 4.4052876934735732, 4.334443680317273, 4.2672424802773659,
+    4.2033137137351844, 4.1423408656640515, 4.0840513104082978, 4.0282085446479368,
+    3.9746060666737888, 3.9230625001354897, 3.8734176703995091, 3.8255294185223367,
+    3.7792709924116679, 3.7345288940397974, 3.6912010902374188, 3.6491955157608538,
+    3.6084288131289095, 3.568825265648337, 3.5303158891293434, 3.4928376547740596,
+    3.4563328211327602, 3.4207483572511199, 3.386035442460301, 3.3521490309001094,
+    3.319047470970748, 3.2866921715990687, 3.2550473085704499, 3.2240795652862642,
+    3.1937579032122403, 3.1640533580259729, 3.1349388580844404, 3.1063890623398245,
+    3.0783802152540902, 3.0508900166154551, 3.0238975044556766, 2.9973829495161306,
+    2.9713277599210897, 2.9457143948950457, 2.9205262865127408, 2.8957477686001418,
+    2.8713640120155364, 2.8473609656351888, 2.8237253024500353, 2.8004443702507378,
+    2.7775061464397566, 2.7548991965623446, 2.7326126361947001, 2.7106360958679288,
+    2.6889596887418037, 2.6675739807732666, 2.6464699631518092, 2.6256390267977885,
+    2.6050729387408356, 2.5847638202141408, 2.5647041263169053, 2.54488662711187,
+    2.525304390037828, 2.505950763528594, 2.4868193617402095, 2.4679040502973648,
+    2.4491989329782498, 2.4306983392644197, 2.4123968126888706, 2.3942890999214579,
+    2.3763701405361406, 2.3586350574093373, 2.3410791477030344, 2.3236978743901964,
+    2.3064868582835798, 2.2894418705322694, 2.2725588255531548, 2.2558337743672192,
+    2.239262898312909, 2.2228425031110368, 2.2065690132576639, 2.19043896672322,
+    2.1744490099377747, 2.158595893043886, 2.142876465399842, 2.1272876713173683,
+    2.1118265460190422, 2.096490211801715, 2.0812758743932251, 2.0661808194905755,
+    2.0512024094685848, 2.0363380802487696, 2.0215853383189262, 2.0069417578945186,
+    1.9924049782135766, 1.9779727009573604, 1.9636426877895483, 1.9494127580071849,
+    1.9352807862970514, 1.9212447005915281, 1.9073024800183875, 1.8934521529393082,
+    1.8796917950722112, 1.866019527692828, 1.8524335159111756, 1.83893196701888,
+    1.8255131289035198, 1.8121752885263906, 1.7989167704602909, 1.785735935484126,
+    1.7726311792313056, 1.7596009308890748, 1.7466436519460744, 1.7337578349855716,
+    1.7209420025219353, 1.7081947058780578, 1.6955145241015379, 1.6829000629175539,
+    1.6703499537164521, 1.6578628525741728, 1.6454374393037237, 1.6330724165359913,
+    1.6207665088282579, 1.6085184617988584, 1.5963270412864834, 1.5841910325326889,
+    1.5721092393862297, 1.5600804835278881, 1.5481036037145135, 1.5361774550410321,
+    1.5243009082192263, 1.5124728488721171, 1.5006921768428167, 1.4889578055167461,
+    1.4772686611561339, 1.4656236822457454, 1.4540218188487934, 1.4424620319720125,
+    1.4309432929388797, 1.4194645827699832, 1.4080248915695357, 1.3966232179170421,
+    1.3852585682631222, 1.3739299563284908, 1.362636402505087, 1.3513769332583354,
+    1.3401505805295051, 1.328956381137117, 1.3177933761763252, 1.3066606104151746,
+    1.2955571316866015, 1.2844819902750131, 1.2734342382962416, 1.2624129290696158,
+    1.251417116480853, 1.240445854334407, 1.2294981956938498, 1.218573192208791,
+    1.2076698934267622, 1.196787346088404, 1.1859245934042031, 1.1750806743109123,
+    1.1642546227056796, 1.1534454666557754, 1.1426522275816735, 1.1318739194110792,
+    1.1211095477013311, 1.1103581087274119, 1.0996185885325982, 1.0888899619385479,
+    1.0781711915113732, 1.0674612264799688, 1.0567590016025523, 1.0460634359770451,
+    1.0353734317905294, 1.0246878730026183, 1.0140056239570978, 1.0033255279156981,
+    0.99264640550727723, 0.98196705308506393, 0.97128624098390481, 0.96060271166866795,
+    0.94991517776407741, 0.93922231995526384, 0.92852278474721195, 0.91781518207004575,
+    0.90709808271569181, 0.89637001558989149, 0.88562946476175308, 0.87487486629102673,
+    0.86410460481100604, 0.85331700984237491, 0.84251035181037004, 0.83168283773427465,
+    0.82083260655441337, 0.80995772405741995, 0.79905617735548873, 0.7881258688694941,
+    0.77716460975913126, 0.76617011273543623, 0.7551399841819838, 0.74407171550050955,
+    0.73296267358436695, 0.72181009030875776, 0.71061105090965648, 0.6993624811032334,
+    0.68806113277374936, 0.67670356802952414, 0.66528614139267939, 0.6538049798476665,
+    0.64225596042453792, 0.63063468493349195, 0.61893645139487774, 0.60715622162030169,
+    0.59528858429150444, 0.58332771274877115, 0.57126731653258989, 0.55910058551154218,
+    0.54682012516331213, 0.53441788123716705, 0.52188505159213661, 0.50921198244365595,
+    0.4963880455186726, 0.4834014916534633, 0.47023927508217045, 0.45688684093142179,
+    0.44332786607355412, 0.42954394022541259, 0.41551416960035825, 0.4012146788962796,
+    0.3866179779411214, 0.37169214532991918, 0.3563997602583957, 0.34069648106485118,
+    0.32452911701691145, 0.30783295467493427, 0.29052795549123261, 0.27251318547846703,
+    0.25365836338591446, 0.23379048305967726, 0.21267151063096923, 0.18995868962243467,
+    0.16512762256419042, 0.13730498094001628, 0.10483850756582322, 0.063852163815007607,
+    0.0,
+};
+
+static const double dawn__ziggurat_exp_f[257] = {
+    0.00016706669230796367, 0.0004541343538414966, 0.0009672692823271743, 0.0015362997803015726,
+    0.002145967743718907, 0.0027887987935740757, 0.003460264777836904, 0.004157295120833797,
+    0.004877655983542396, 0.005619642207205489, 0.006381905937319183, 0.007163353183634991,
+    0.007963077438017043, 0.008780314985808977, 0.009614413642502212, 0.01046481018102998,
+    0.0113310135978346, 0.012212592426255378, 0.013109164931254991, 0.014020391403181943,
+    0.014945968011691148, 0.015885621839973156, 0.01683910682603994, 0.017806200410911355,
+    0.018786700744696024, 0.01978042433800974, 0.020787204072578114, 0.02180688750428358,
+    0.02283933540638524, 0.023884420511558174, 0.024942026419731787, 0.02601204664513422,
+    0.027094383780955803, 0.028188948763978646, 0.02929566022463741, 0.03041444391046662,
+    0.03154523217289362, 0.032687963508959555, 0.03384258215087436, 0.03500903769739743,
+    0.03618728478193144, 0.03737728277295938, 0.03857899550307487, 0.03979239102337414,
+    0.04101744138041484, 0.042254122413316254, 0.0435024135688882, 0.04476229773294329,
+    0.046033761076175184, 0.04731679291318156, 0.048611385573379504, 0.04991753428270638,
+    0.05123523705512628, 0.052564494593071685, 0.05390531019604608, 0.05525768967669703,
+    0.05662164128374287, 0.05799717563120066, 0.05938430563342028, 0.06078304644547966,
+    0.062193415408541036, 0.06361543199980738, 0.0650491177867538, 0.06649449638533982,
+    0.06795159342193664, 0.06942043649872878, 0.07090105516237184, 0.07239348087570875,
+    0.07389774699236475, 0.07541388873405841, 0.07694194317048052, 0.07848194920160644,
+    0.0800339475423199, 0.08159798070923742, 0.0831740930096324, 0.08476233053236815,
+    0.08636274114075693, 0.08797537446727023, 0.08960028191003289, 0.0912375166310402,
+    0.09288713355604357, 0.09454918937605587, 0.09622374255043283, 0.09791085331149221,
+    0.09961058367063713, 0.10132299742595363, 0.1030481601712577, 0.10478613930657016,
+    0.10653700405000163, 0.10830082545103376, 0.11007767640518536, 0.11186763167005628,
+    0.11367076788274429, 0.1154871635786335, 0.11731689921155553, 0.11916005717532764,
+    0.12101672182667479, 0.12288697950954511, 0.12477091858083093, 0.12666862943751067,
+    0.1285802045452282, 0.13050573846833077, 0.1324453279013875, 0.1343990717022136,
+    0.13636707092642883, 0.13834942886358018, 0.1403462510748624, 0.14235764543247215,
+    0.14438372216063472, 0.1464245938783449, 0.14848037564386674, 0.15055118500103984,
+    0.1526371420274428, 0.15473836938446803, 0.15685499236936515, 0.15898713896931413,
+    0.16113493991759195, 0.16329852875190173, 0.16547804187493592, 0.16767361861725008,
+    0.16988540130252755, 0.17211353531531998, 0.1743581691713534, 0.17661945459049483,
+    0.17889754657247828, 0.18119260347549626, 0.18350478709776744, 0.18583426276219708,
+    0.18818119940425426, 0.19054576966319536, 0.1929281499767713, 0.1953285206795632,
+    0.19774706610509882, 0.2001839746919112, 0.20263943909370896, 0.20511365629383765,
+    0.20760682772422198, 0.21011915938898823, 0.21265086199297822, 0.21520215107537863,
+    0.21777324714870047, 0.22036437584335944, 0.2229757680581201, 0.22560766011668396,
+    0.22826029393071662, 0.23093391716962736, 0.2336287834374333, 0.23634515245705956,
+    0.2390832902624491, 0.24184346939887713, 0.24462596913189202, 0.24743107566532754,
+    0.2502590823688622, 0.25311029001562935, 0.25598500703041527, 0.25888354974901606,
+    0.2618062426893628, 0.26475341883506204, 0.26772541993204463, 0.27072259679905986,
+    0.2737453096528028, 0.2767939284485172, 0.27986883323697276, 0.28297041453878063,
+    0.2860990737370767, 0.2892552234896776, 0.2924392881618924, 0.295651704281261,
+    0.2988929210155815, 0.3021634006756933, 0.30546361924459003, 0.30879406693455996,
+    0.3121552487741794, 0.3155476852271287, 0.318971912844957, 0.322428484956089,
+    0.325917972393556, 0.32944096426413616, 0.33299806876180876, 0.3365899140286774,
+    0.34021714906677986, 0.34388044470450224, 0.3475804946216368, 0.35131801643748317,
+    0.3550937528667873, 0.35890847294874956, 0.3627629733548175, 0.3666580797815139,
+    0.3705946484351457, 0.3745735676159019, 0.3785957594095805, 0.3826621814960095,
+    0.3867738290841374, 0.3909317369847968, 0.3951369818332898, 0.39939068447523074,
+    0.40369401253052994, 0.40804818315203206, 0.41245446599716085, 0.41691418643300254,
+    0.42142872899761624, 0.425999541143034, 0.4306281372884585, 0.43531610321563624,
+    0.4400651008423535, 0.4448768734145481, 0.4497532511627546, 0.4546961574746151,
+    0.4597076156421373, 0.4647897562504258, 0.4699448252839596, 0.475175193037377,
+    0.4804833639304538, 0.4858719873418845, 0.49134386959403215, 0.49690198724154916,
+    0.5025495018413473, 0.5082897764106424, 0.5141263938147481, 0.5200631773682332,
+    0.5261042139836193, 0.5322538802630428, 0.5385168720028614, 0.5448982376724392,
+    0.5514034165406408, 0.558038282262587, 0.5648091929123997, 0.5717230486648253,
+    0.5787873586028445, 0.5860103184772675, 0.5934009016917329, 0.6009689663652317,
+    0.6087253820796215, 0.616682180915207, 0.6248527387036653, 0.6332519942143654,
+    0.6418967164272653, 0.6508058334145702, 0.6600008410789989, 0.669506316731924,
+    0.6793505722647646, 0.6895664961170771, 0.7001926550827873, 0.711274760805075,
+    0.722867659593571, 0.7350380924314225, 0.747868621985194, 0.7614633888498951,
+    0.7759568520401143, 0.7915276369724943, 0.8084216515230069, 0.8269932966430488,
+    0.8477855006239878, 0.8717043323812015, 0.9004699299257437, 0.9381436808621708,
+    1.0,
+};
+
+// exp and log for the samplers, so that DAWN_IMPLEMENTATION does not need
+// to be linked with libm. Both are accurate to a few ulp.
+static double dawn__exp(double x) {
+    if (x < -708.0) return 0.0;
+    assert(x < 709.0);
+    // x = k*ln(2) + r with |r| <= ln(2)/2, exp(r) by its Taylor series.
+    double k = (double)(int64_t)(x * 1.4426950408889634 + (x < 0 ? -0.5 : 0.5));
+    double r = (x - k * 6.93147180369123816490e-01) - k * 1.90821492927058770002e-10;
+    double p = 1.0 / 6227020800.0;
+    static const double inverse_factorials[] = {
+        1.0 / 479001600.0, 1.0 / 39916800.0, 1.0 / 3628800.0, 1.0 / 362880.0, 1.0 / 40320.0, 1.0 / 5040.0,
+        1.0 / 720.0, 1.0 / 120.0, 1.0 / 24.0, 1.0 / 6.0, 0.5, 1.0, 1.0,
+    };
+    for (size_t i = 0; i < sizeof inverse_factorials / sizeof *inverse_factorials; ++i) {
+        p = p * r + inverse_factorials[i];
+    }
+    uint64_t scale_bits = (uint64_t)((int64_t)k + 1023) << 52;
+    double scale;
+    memcpy(&scale, &scale_bits, sizeof scale);
+    return p * scale;
+}
+
+// Only for positive normal numbers, which is all that dawn__rng_open01 returns.
+static double dawn__log(double x) {
+    uint64_t bits;
+    memcpy(&bits, &x, sizeof bits);
+    assert(x > 0 && (bits >> 52) != 0);
+    int64_t e = (int64_t)(bits >> 52) - 1023;
+    bits = (bits & 0x000FFFFFFFFFFFFFull) | 0x3FF0000000000000ull;
+    double m;
+    memcpy(&m, &bits, sizeof m);
+    if (m > 1.4142135623730951) {
+        m *= 0.5;
+        e++;
+    }
+    // log(m) = 2*atanh(s) with |s| <= 0.172, summed up to s^21.
+    double s = (m - 1.0) / (m + 1.0);
+    double s2 = s * s;
+    double p = 1.0 / 21.0;
+    for (int n = 19; n >= 1; n -= 2) p = p * s2 + 1.0 / n;
+    return (double)e * 6.93147180369123816490e-01 + ((double)e * 1.90821492927058770002e-10 + 2.0 * s * p);
+}
+
+// A double in (0, 1), safe to take the logarithm of.
+static inline double dawn__rng_open01(DawnRng *rng) {
+    return ((double)(dawn_rng_u64(rng) >> 11) + 0.5) * 0x1.0p-53;
+}
+
+static double dawn__normal_from_bits(DawnRng *rng, uint64_t bits) {
+    for (;;) {
+        // The low 8 bits pick the layer, the high 52 bits give u in [-1, 1).
+        size_t i = bits & 0xFF;
+        double u = (double)(bits >> 12) * 0x1.0p-51 - 1.0;
+        double x = u * dawn__ziggurat_normal_x[i];
+        if ((x < 0 ? -x : x) < dawn__ziggurat_normal_x[i + 1]) return x;
+        if (i == 0) {
+            // Tail beyond R, with G. Marsaglia's method.
+            double tail_x, tail_y;
+            do {
+                tail_x = dawn__log(dawn__rng_open01(rng)) / DAWN__ZIGGURAT_NORMAL_R;
+                tail_y = dawn__log(dawn__rng_open01(rng));
+            } while (-2.0 * tail_y < tail_x * tail_x);
+            return u < 0 ? tail_x - DAWN__ZIGGURAT_NORMAL_R : DAWN__ZIGGURAT_NORMAL_R - tail_x;
+        }
+        double f0 = dawn__ziggurat_normal_f[i];
+        double f1 = dawn__ziggurat_normal_f[i + 1];
+        if (f1 + (f0 - f1) * dawn_rng_double(rng) < dawn__exp(-0.5 * x * x)) return x;
+        bits = dawn_rng_u64(rng);
+    }
+}
+
+static double dawn__exponential_from_bits(DawnRng *rng, uint64_t bits) {
+    for (;;) {
+        size_t i = bits & 0xFF;
+        double u = (double)(bits >> 12) * 0x1.0p-52;
+        double x = u * dawn__ziggurat_exp_x[i];
+        if (x < dawn__ziggurat_exp_x[i + 1]) return x;
+        // The exponential distribution is memoryless, so its tail is R plus another sample.
+        if (i == 0) return DAWN__ZIGGURAT_EXP_R - dawn__log(dawn__rng_open01(rng));
+        double f0 = dawn__ziggurat_exp_f[i];
+        double f1 = dawn__ziggurat_exp_f[i + 1];
+        if (f1 + (f0 - f1) * dawn_rng_double(rng) < dawn__exp(-x)) return x;
+        bits = dawn_rng_u64(rng);
+    }
+}
+
+double dawn_rng_normal(DawnRng *rng) {
+    return dawn__normal_from_bits(rng, dawn_rng_u64(rng));
+}
+
+double dawn_rng_exponential(DawnRng *rng) {
+    return dawn__exponential_from_bits(rng, dawn_rng_u64(rng));
+}
+
+static void dawn__xoshiro_jump(DawnRng *rng, const uint64_t polynomial[4]) {
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (polynomial[i] & (uint64_t)1 << b) {
+                s0 ^= rng->state[0];
+                s1 ^= rng->state[1];
+                s2 ^= rng->state[2];
+                s3 ^= rng->state[3];
+            }
+            dawn_rng_u64(rng);
+        }
+    }
+    rng->state[0] = s0;
+    rng->state[1] = s1;
+    rng->state[2] = s2;
+    rng->state[3] = s3;
+}
+
+// Low 128 bits of a * b, where each operand is given as {lo, hi}.
+static inline void dawn__mul128_lo(const uint64_t a[2], const uint64_t b[2], uint64_t out[2]) {
+    uint64_t hi;
+    uint64_t lo = dawn__mul128(a[0], b[0], &hi);
+    out[1] = hi + a[0] * b[1] + a[1] * b[0];
+    out[0] = lo;
+}
+
+static inline void dawn__add128(const uint64_t a[2], const uint64_t b[2], uint64_t out[2]) {
+    uint64_t lo = a[0] + b[0];
+    out[1] = a[1] + b[1] + (lo < a[0]);
+    out[0] = lo;
+}
+
+// Advances the LCG by 2^log2_delta steps in O(log2_delta), see F. Brown,
+// "Random Number Generation with Arbitrary Stride", 1994. Squaring the step
+// log2_delta times composes it with itself 2^log2_delta times.
+static void dawn__pcg64_advance_pow2(uint64_t *state, unsigned log2_delta) {
+    uint64_t multiplier[2] = {DAWN__PCG64_MULTIPLIER_LO, DAWN__PCG64_MULTIPLIER_HI};
+    uint64_t increment[2] = {state[2], state[3]};
+    const uint64_t one[2] = {1, 0};
+    for (unsigned i = 0; i < log2_delta; i++) {
+        // (x * m + c) * m + c = x * m^2 + (m + 1) * c
+        uint64_t m_plus_one[2];
+        dawn__add128(multiplier, one, m_plus_one);
+        dawn__mul128_lo(m_plus_one, increment, increment);
+        dawn__mul128_lo(multiplier, multiplier, multiplier);
+    }
+    uint64_t next[2];
+    dawn__mul128_lo(multiplier, state, next);
+    dawn__add128(next, increment, state);
+}
+
+void dawn_rng_jump(DawnRng *rng) {
+    if (rng->kind == DAWN_RNG_XOSHIRO256PP) {
+        static const uint64_t jump[4] = {
+            0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull,
+        };
+        dawn__xoshiro_jump(rng, jump);
+    } else {
+        dawn__pcg64_advance_pow2(rng->state, 64);
+    }
+}
+
+void dawn_rng_long_jump(DawnRng *rng) {
+    if (rng->kind == DAWN_RNG_XOSHIRO256PP) {
+        static const uint64_t long_jump[4] = {
+            0x76E15D3EFEFDCBBFull, 0xC5004E441C522FB3ull, 0x77710069854EE241ull, 0x39109BB02ACBE635ull,
+        };
+        dawn__xoshiro_jump(rng, long_jump);
+    } else {
+        dawn__pcg64_advance_pow2(rng->state, 96);
+    }
+}
+
+void dawn_rng_split(const DawnRng *rng, DawnRng *streams, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        streams[i] = i == 0 ? *rng : streams[i - 1];
+        if (i > 0) dawn_rng_jump(&streams[i]);
+    }
+}
+
+// Fills shorter than this are not worth seeding the lanes for.
+#define DAWN__RNG_LANES_MIN 64
+#define DAWN__RNG_LANES 8
+
+// Eight xoshiro256++ generators; s[i] holds word i of every lane.
+typedef struct {
+    uint64_t s[4][DAWN__RNG_LANES];
+} Dawn__RngLanes;
+
+static void dawn__rng_lanes_seed(Dawn__RngLanes *lanes, DawnRng *rng) {
+    for (int lane = 0; lane < DAWN__RNG_LANES; lane++) {
+        uint64_t seed = dawn_rng_u64(rng);
+        for (int word = 0; word < 4; word++) {
+            lanes->s[word][lane] = dawn__splitmix64(&seed);
+        }
+    }
+}
+
+#ifdef DAWN_HAS_AVX2
+static inline __m256i dawn__rotl64_avx2(__m256i x, int k) {
+    return _mm256_or_si256(_mm256_slli_epi64(x, k), _mm256_srli_epi64(x, 64 - k));
+}
+
+static inline __m256i dawn__xoshiro_avx2(__m256i *s) {
+    __m256i result = _mm256_add_epi64(dawn__rotl64_avx2(_mm256_add_epi64(s[0], s[3]), 23), s[0]);
+    __m256i t = _mm256_slli_epi64(s[1], 17);
+    s[2] = _mm256_xor_si256(s[2], s[0]);
+    s[3] = _mm256_xor_si256(s[3], s[1]);
+    s[1] = _mm256_xor_si256(s[1], s[2]);
+    s[0] = _mm256_xor_si256(s[0], s[3]);
+    s[2] = _mm256_xor_si256(s[2], t);
+    s[3] = dawn__rotl64_avx2(s[3], 45);
+    return result;
+}
+
+static inline void dawn__rng_lanes_load(const Dawn__RngLanes *lanes, __m256i *a, __m256i *b) {
+    for (int word = 0; word < 4; word++) {
+        a[word] = _mm256_loadu_si256((const __m256i *)&lanes->s[word][0]);
+        b[word] = _mm256_loadu_si256((const __m256i *)&lanes->s[word][4]);
+    }
+}
+
+static inline __m256 dawn__unit_floats_avx2(__m256i bits) {
+    __m256i one_to_two = _mm256_or_si256(_mm256_srli_epi32(bits, 9), _mm256_set1_epi32(0x3F800000));
+    return _mm256_sub_ps(_mm256_castsi256_ps(one_to_two), _mm256_set1_ps(1.0f));
+}
+#else
+static inline void dawn__rng_lanes_next(Dawn__RngLanes *lanes, uint64_t *out) {
+    uint64_t *s0 = lanes->s[0];
+    uint64_t *s1 = lanes->s[1];
+    uint64_t *s2 = lanes->s[2];
+    uint64_t *s3 = lanes->s[3];
+    for (int lane = 0; lane < DAWN__RNG_LANES; lane++) {
+        out[lane] = dawn__rotl64(s0[lane] + s3[lane], 23) + s0[lane];
+        uint64_t t = s1[lane] << 17;
+        s2[lane] ^= s0[lane];
+        s3[lane] ^= s1[lane];
+        s1[lane] ^= s2[lane];
+        s0[lane] ^= s3[lane];
+        s2[lane] ^= t;
+        s3[lane] = dawn__rotl64(s3[lane], 45);
+    }
+}
+#endif
+
+void dawn_rng_fill_u64(DawnRng *rng, uint64_t *out, size_t n) {
+    size_t i = 0;
+    if (rng->kind == DAWN_RNG_XOSHIRO256PP && n >= DAWN__RNG_LANES_MIN) {
+        Dawn__RngLanes lanes;
+        dawn__rng_lanes_seed(&lanes, rng);
+#ifdef DAWN_HAS_AVX2
+        __m256i a[4], b[4];
+        dawn__rng_lanes_load(&lanes, a, b);
+        for (; i + DAWN__RNG_LANES <= n; i += DAWN__RNG_LANES) {
+            _mm256_storeu_si256((__m256i *)(out + i), dawn__xoshiro_avx2(a));
+            _mm256_storeu_si256((__m256i *)(out + i + 4), dawn__xoshiro_avx2(b));
+        }
+#else
+        for (; i + DAWN__RNG_LANES <= n; i += DAWN__RNG_LANES) {
+            dawn__rng_lanes_next(&lanes, out + i);
+        }
+#endif
+    }
+    for (; i < n; i++) {
+        out[i] = dawn_rng_u64(rng);
+    }
+}
+
+void dawn_rng_fill_float(DawnRng *rng, float *out, size_t n) {
+    size_t i = 0;
+    if (rng->kind == DAWN_RNG_XOSHIRO256PP && n >= DAWN__RNG_LANES_MIN) {
+        Dawn__RngLanes lanes;
+        dawn__rng_lanes_seed(&lanes, rng);
+        // Every 64-bit output gives two floats.
+#ifdef DAWN_HAS_AVX2
+        __m256i a[4], b[4];
+        dawn__rng_lanes_load(&lanes, a, b);
+        for (; i + 2 * DAWN__RNG_LANES <= n; i += 2 * DAWN__RNG_LANES) {
+            _mm256_storeu_ps(out + i, dawn__unit_floats_avx2(dawn__xoshiro_avx2(a)));
+            _mm256_storeu_ps(out + i + 8, dawn__unit_floats_avx2(dawn__xoshiro_avx2(b)));
+        }
+#else
+        uint64_t bits[DAWN__RNG_LANES];
+        for (; i + 2 * DAWN__RNG_LANES <= n; i += 2 * DAWN__RNG_LANES) {
+            dawn__rng_lanes_next(&lanes, bits);
+            for (int lane = 0; lane < DAWN__RNG_LANES; lane++) {
+                uint32_t halves[2] = {(uint32_t)bits[lane], (uint32_t)(bits[lane] >> 32)};
+                for (int k = 0; k < 2; k++) {
+                    uint32_t one_to_two = halves[k] >> 9 | 0x3F800000;
+                    float f;
+                    memcpy(&f, &one_to_two, sizeof f);
+                    out[i + 2 * lane + k] = f - 1.0f;
+                }
+            }
+        }
+#endif
+    }
+    for (; i < n; i++) {
+        out[i] = dawn_rng_float(rng);
+    }
+}
+
+void dawn_rng_fill_bounded(DawnRng *rng, uint64_t *out, size_t count, uint64_t n) {
+    assert(n > 0);
+    dawn_rng_fill_u64(rng, out, count);
+    for (size_t i = 0; i < count; i++) {
+        out[i] = dawn__bounded_from_bits(rng, out[i], n);
+    }
+}
+
+#define DAWN__RNG_CHUNK 512
+
+void dawn_rng_fill_normal(DawnRng *rng, double *out, size_t n) {
+    uint64_t bits[DAWN__RNG_CHUNK];
+    for (size_t i = 0; i < n; i += DAWN__RNG_CHUNK) {
+        size_t chunk = n - i < DAWN__RNG_CHUNK ? n - i : DAWN__RNG_CHUNK;
+        dawn_rng_fill_u64(rng, bits, chunk);
+        for (size_t k = 0; k < chunk; k++) {
+            out[i + k] = dawn__normal_from_bits(rng, bits[k]);
+        }
+    }
+}
+
+void dawn_rng_fill_exponential(DawnRng *rng, double *out, size_t n) {
+    uint64_t bits[DAWN__RNG_CHUNK];
+    for (size_t i = 0; i < n; i += DAWN__RNG_CHUNK) {
+        size_t chunk = n - i < DAWN__RNG_CHUNK ? n - i : DAWN__RNG_CHUNK;
+        dawn_rng_fill_u64(rng, bits, chunk);
+        for (size_t k = 0; k < chunk; k++) {
+            out[i + k] = dawn__exponential_from_bits(rng, bits[k]);
+        }
+    }
+}
+
+/*********
+ *Divider*
+ *********/
+
+// m = floor(2^32 * (2^l - n) / n) + 1 with l = ceil(log2(n)), which makes
+// (t + ((x - t) >> 1)) >> (l - 1) with t = mulhi(m, x) exact for every x.
+void dawn_divider32_init(DawnDivider32 *d, uint32_t n) {
+    assert(n != 0 && "Division by zero");
+    d->divisor = n;
+    d->power_of_two = (n & (n - 1)) == 0;
+    if (d->power_of_two) {
+        d->magic = 0;
+        d->shift1 = 0;
+        d->shift2 = (uint8_t)dawn__ctz32(n);
+        return;
+    }
+    unsigned l = 64 - dawn__clz64((uint64_t)n - 1);
+    d->magic = (uint32_t)(((((uint64_t)1 << l) - n) << 32) / n + 1);
+    d->shift1 = 1;
+    d->shift2 = (uint8_t)(l - 1);
+}
+
+void dawn_divider64_init(DawnDivider64 *d, uint64_t n) {
+    assert(n != 0 && "Division by zero");
+    d->divisor = n;
+    d->power_of_two = (n & (n - 1)) == 0;
+    if (d->power_of_two) {
+        d->magic = 0;
+        d->shift1 = 0;
+        d->shift2 = (uint8_t)dawn__ctz64(n);
+        return;
+    }
+    unsigned l = 64 - dawn__clz64(n - 1);
+    // 2^l - n wraps to the right value for l == 64 and is below n, so the
+    // 128 by 64 bit quotient fits in 64 bits.
+    uint64_t rem = ((l == 64) ? 0 : ((uint64_t)1 << l)) - n;
+#if defined(__SIZEOF_INT128__)
+    d->magic = (uint64_t)(((__uint128_t)rem << 64) / n) + 1;
+#else
+    uint64_t quotient = 0;
+    for (int i = 0; i < 64; ++i) {
+        uint64_t carry = rem >> 63;
+        rem <<= 1;
+        quotient <<= 1;
+        if (carry || rem >= n) {
+            rem -= n;
+            quotient |= 1;
+        }
+    }
+    d->magic = quotient + 1;
+#endif
+    d->shift1 = 1;
+    d->shift2 = (uint8_t)(l - 1);
+}
+
+#ifdef DAWN_HAS_AVX2
+static inline __m256i dawn__mulhi_epu32(__m256i x, __m256i magic) {
+    __m256i even = _mm256_srli_epi64(_mm256_mul_epu32(x, magic), 32);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), magic);
+    return _mm256_blend_epi32(even, odd, 0xAA);
+}
+#endif
+
+void dawn_mod_array(int *out, const int *in, size_t count, int n) {
+    assert(n != 0 && "Division by zero");
+    if (n < 0) {
+        for (size_t i = 0; i < count; ++i) out[i] = dawn_mod(in[i], n);
+        return;
+    }
+    DawnDivider32 d;
+    dawn_divider32_init(&d, (uint32_t)n);
+    size_t i = 0;
+#ifdef DAWN_HAS_AVX2
+    __m256i divisor = _mm256_set1_epi32(n);
+    if (d.power_of_two) {
+        __m256i mask = _mm256_set1_epi32(n - 1);
+        for (; i + 8 <= count; i += 8) {
+            __m256i x = _mm256_loadu_si256((const __m256i *)(in + i));
+            _mm256_storeu_si256((__m256i *)(out + i), _mm256_and_si256(x, mask));
+        }
+    } else {
+        __m256i magic = _mm256_set1_epi32((int)d.magic);
+        __m128i shift2 = _mm_cvtsi32_si128(d.shift2);
+        for (; i + 8 <= count; i += 8) {
+            __m256i x = _mm256_loadu_si256((const __m256i *)(in + i));
+            __m256i sign = _mm256_srai_epi32(x, 31);
+            __m256i u = _mm256_xor_si256(x, sign);
+            __m256i t = dawn__mulhi_epu32(u, magic);
+            __m256i q = _mm256_add_epi32(t, _mm256_srli_epi32(_mm256_sub_epi32(u, t), 1));
+            q = _mm256_xor_si256(_mm256_srl_epi32(q, shift2), sign);
+            __m256i r = _mm256_sub_epi32(x, _mm256_mullo_epi32(q, divisor));
+            _mm256_storeu_si256((__m256i *)(out + i), r);
+        }
+    }
+#endif
+    for (; i < count; ++i) out[i] = dawn_mod_i32(in[i], &d);
+}
+
+/*********
+ *Sorting*
+ *********/
+
+// Signed and float keys are mapped in place to unsigned integers with the
+// same order before sorting, and mapped back afterwards.
+static void dawn__radix_map_keys(unsigned char *items, size_t count, size_t item_size, size_t key_offset, DawnRadixKey key, bool forward) {
+    if (key == DAWN_RADIX_U32 || key == DAWN_RADIX_U64) return;
+    bool wide = key == DAWN_RADIX_U64 || key == DAWN_RADIX_I64 || key == DAWN_RADIX_F64;
+    bool is_float = key == DAWN_RADIX_F32 || key == DAWN_RADIX_F64;
+    for (size_t i = 0; i < count; ++i) {
+        unsigned char *p = items + i*item_size + key_offset;
+        if (wide) {
+            uint64_t x;
+            memcpy(&x, p, 8);
+            uint64_t sign = 0x8000000000000000ull;
+            // Negative floats have all bits flipped, positive ones only the sign.
+            if (is_float) x ^= (forward ? 0 - (x >> 63) : (x >> 63) - 1) | sign;
+            else x ^= sign;
+            memcpy(p, &x, 8);
+        } else {
+            uint32_t x;
+            memcpy(&x, p, 4);
+            uint32_t sign = 0x80000000u;
+            if (is_float) x ^= (forward ? 0 - (x >> 31) : (x >> 31) - 1) | sign;
+            else x ^= sign;
+            memcpy(p, &x, 4);
+        }
+    }
+}
+
+// Called with constant item_size and wide so that every combination gets
+// its own loop with a fixed-size copy.
+static inline void dawn__radix_scatter(const unsigned char *src, unsigned char *dst, size_t count,
+                                       size_t item_size, size_t key_offset, bool wide, unsigned shift, size_t *offsets) {
+    for (size_t i = 0; i < count; ++i) {
+        const unsigned char *item = src + i*item_size;
+        uint64_t k;
+        if (wide) {
+            memcpy(&k, item + key_offset, 8);
+        } else {
+            uint32_t k32;
+            memcpy(&k32, item + key_offset, 4);
+            k = k32;
+        }
+        memcpy(dst + (offsets[(k >> shift) & 0xFF]++)*item_size, item, item_size);
+    }
+}
+
+void dawn_radix_sort(void *items, size_t count, size_t item_size, size_t key_offset, DawnRadixKey key, void *scratch) {
+    if (count < 2) return;
+    bool wide = key == DAWN_RADIX_U64 || key == DAWN_RADIX_I64 || key == DAWN_RADIX_F64;
+    unsigned key_size = wide ? 8 : 4;
+    assert(key_offset + key_size <= item_size);
+
+    unsigned char *buffer = (unsigned char *)scratch;
+    if (buffer == NULL) {
+        buffer = (unsigned char *)malloc(count*item_size);
+        assert(buffer && "Not enough RAM for malloc");
+    }
+    unsigned char *src = (unsigned char *)items;
+    unsigned char *dst = buffer;
+    dawn__radix_map_keys(src, count, item_size, key_offset, key, true);
+
+    size_t histograms[8][256] = {0};
+    for (size_t i = 0; i < count; ++i) {
+        uint64_t k;
+        if (wide) {
+            memcpy(&k, src + i*item_size + key_offset, 8);
+        } else {
+            uint32_t k32;
+            memcpy(&k32, src + i*item_size + key_offset, 4);
+            k = k32;
+        }
+        for (unsigned b = 0; b < key_size; ++b) histograms[b][(k >> 8*b) & 0xFF]++;
+    }
+
+    for (unsigned b = 0; b < key_size; ++b) {
+        size_t *offsets = histograms[b];
+        // All keys share this byte, the pass would only copy the array.
+        uint64_t first;
+        if (wide) {
+            memcpy(&first, src + key_offset, 8);
+        } else {
+            uint32_t first32;
+            memcpy(&first32, src + key_offset, 4);
+            first = first32;
+        }
+        if (offsets[(first >> 8*b) & 0xFF] == count) continue;
+
+        size_t sum = 0;
+        for (size_t d = 0; d < 256; ++d) {
+            size_t c = offsets[d];
+            offsets[d] = sum;
+            sum += c;
+        }
+        unsigned shift = 8*b;
+        if (item_size == 4 && !wide) dawn__radix_scatter(src, dst, count, 4, key_offset, false, shift, offsets);
+        else if (item_size == 8 && wide) dawn__radix_scatter(src, dst, count, 8, key_offset, true, shift, offsets);
+        else if (item_size == 8) dawn__radix_scatter(src, dst, count, 8, key_offset, false, shift, offsets);
+        else if (item_size == 16 && wide) dawn__radix_scatter(src, dst, count, 16, key_offset, true, shift, offsets);
+        else if (item_size == 16) dawn__radix_scatter(src, dst, count, 16, key_offset, false, shift, offsets);
+        else dawn__radix_scatter(src, dst, count, item_size, key_offset, wide, shift, offsets);
+        unsigned char *temp = src;
+        src = dst;
+        dst = temp;
+    }
+
+    if (src != items) memcpy(items, src, count*item_size);
+    dawn__radix_map_keys((unsigned char *)items, count, item_size, key_offset, key, false);
+    if (scratch == NULL) free(buffer);
+}
+
+// Runs and merge pieces of the parallel sort, in items. Fixed so that the
+// result does not depend on the thread count.
+#define DAWN__PARALLEL_SORT_RUN (1 << 16)
+
+typedef struct {
+    const DawnSortFunctions *functions;
+    unsigned char *src;
+    unsigned char *dst;
+    size_t count;
+    // Width of the sorted runs that the current level merges in pairs.
+    size_t width;
+} Dawn__ParallelSort;
+
+typedef void (*Dawn__PoolTask)(void *ctx, size_t task);
+
+#ifdef DAWN__HAS_PTHREAD
+// Tasks [begin, end) of one worker. The owner pops from the end, thieves
+// take from the start, which keeps neighbouring tasks on one thread.
+// generation tags the dawn__pool_run call that filled the queue.
+typedef struct {
+    pthread_mutex_t lock;
+    uint64_t generation;
+    size_t begin;
+    size_t end;
+} Dawn__TaskQueue;
+
+typedef struct {
+    pthread_mutex_t lock;
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    Dawn__TaskQueue *queues;
+    size_t thread_count;
+    Dawn__PoolTask run;
+    void *ctx;
+    size_t pending;
+    uint64_t generation;
+    bool stop;
+} Dawn__Pool;
+
+typedef struct {
+    Dawn__Pool *pool;
+    size_t index;
+} Dawn__PoolWorker;
+
+// Only tasks of the given generation are taken, so a worker still leaving
+// the previous run cannot start tasks of the next one.
+static bool dawn__pool_take(Dawn__Pool *pool, size_t worker, uint64_t generation, size_t *task) {
+    Dawn__TaskQueue *own = &pool->queues[worker];
+    pthread_mutex_lock(&own->lock);
+    bool found = own->generation == generation && own->begin < own->end;
+    if (found) *task = --own->end;
+    pthread_mutex_unlock(&own->lock);
+    for (size_t i = 1; !found && i < pool->thread_count; ++i) {
+        Dawn__TaskQueue *victim = &pool->queues[(worker + i) % pool->thread_count];
+        pthread_mutex_lock(&victim->lock);
+        found = victim->generation == generation && victim->begin < victim->end;
+        if (found) *task = victim->begin++;
+        pthread_mutex_unlock(&victim->lock);
+    }
+    return found;
+}
+
+static void dawn__pool_work(Dawn__Pool *pool, size_t worker, uint64_t generation) {
+    size_t task;
+    while (dawn__pool_take(pool, worker, generation, &task)) {
+        pool->run(pool->ctx, task);
+        pthread_mutex_lock(&pool->lock);
+        if (--pool->pending == 0) pthread_cond_signal(&pool->work_done);
+        pthread_mutex_unlock(&pool->lock);
+    }
+}
+
+static void *dawn__pool_thread(void *arg) {
+    Dawn__PoolWorker *worker = (Dawn__PoolWorker *)arg;
+    Dawn__Pool *pool = worker->pool;
+    uint64_t seen = 0;
+    for (;;) {
+        pthread_mutex_lock(&pool->lock);
+        while (!pool->stop && pool->generation == seen) pthread_cond_wait(&pool->work_ready, &pool->lock);
+        bool stop = pool->stop;
+        seen = pool->generation;
+        pthread_mutex_unlock(&pool->lock);
+        if (stop) return NULL;
+        dawn__pool_work(pool, worker->index, seen);
+    }
+}
+
+// Run tasks 0 to task_count - 1 and wait for them, the calling thread
+// being worker 0. The task count is set before any queue is filled, so
+// every finished task is counted against this run.
+static void dawn__pool_run(Dawn__Pool *pool, Dawn__PoolTask run, void *ctx, size_t task_count) {
+    if (task_count == 0) return;
+    // Only this thread changes generation, so it may read it unlocked.
+    uint64_t generation = pool->generation + 1;
+    pthread_mutex_lock(&pool->lock);
+    pool->run = run;
+    pool->ctx = ctx;
+    pool->pending = task_count;
+    pthread_mutex_unlock(&pool->lock);
+    for (size_t i = 0; i < pool->thread_count; ++i) {
+        Dawn__TaskQueue *queue = &pool->queues[i];
+        pthread_mutex_lock(&queue->lock);
+        queue->generation = generation;
+        queue->begin = task_count*i/pool->thread_count;
+        queue->end = task_count*(i + 1)/pool->thread_count;
+        pthread_mutex_unlock(&queue->lock);
+    }
+    pthread_mutex_lock(&pool->lock);
+    pool->generation = generation;
+    pthread_cond_broadcast(&pool->work_ready);
+    pthread_mutex_unlock(&pool->lock);
+
+    dawn__pool_work(pool, 0, generation);
+
+    pthread_mutex_lock(&pool->lock);
+    while (pool->pending > 0) pthread_cond_wait(&pool->work_done, &pool->lock);
+    pthread_mutex_unlock(&pool->lock);
+}
+#endif
+
+// Index of the first item of a that comes after the first k items of the
+// stable merge of a and b.
+static size_t dawn__merge_split(const DawnSortFunctions *f, const unsigned char *a, size_t count_a,
+                                const unsigned char *b, size_t count_b, size_t k) {
+    size_t lo = k > count_b ? k - count_b : 0;
+    size_t hi = k < count_a ? k : count_a;
+    while (lo < hi) {
+        size_t i = lo + (hi - lo)/2;
+        size_t j = k - i;
+        // a[i] also belongs before b[j - 1].
+        if (!f->less(b + (j - 1)*f->item_size, a + i*f->item_size)) lo = i + 1;
+        else hi = i;
+    }
+    return lo;
+}
+
+static void dawn__parallel_sort_run(void *ctx, size_t task) {
+    Dawn__ParallelSort *ps = (Dawn__ParallelSort *)ctx;
+    size_t begin = task*DAWN__PARALLEL_SORT_RUN;
+    size_t end = begin + DAWN__PARALLEL_SORT_RUN < ps->count ? begin + DAWN__PARALLEL_SORT_RUN : ps->count;
+    ps->functions->sort(ps->src + begin*ps->functions->item_size, end - begin);
+}
+
+static void dawn__parallel_sort_merge(void *ctx, size_t task) {
+    Dawn__ParallelSort *ps = (Dawn__ParallelSort *)ctx;
+    const DawnSortFunctions *f = ps->functions;
+    size_t pieces_per_pair = 2*ps->width/DAWN__PARALLEL_SORT_RUN;
+    size_t start = task/pieces_per_pair*2*ps->width;
+    size_t mid = start + ps->width < ps->count ? start + ps->width : ps->count;
+    size_t stop = mid + ps->width < ps->count ? mid + ps->width : ps->count;
+    size_t k0 = task%pieces_per_pair*DAWN__PARALLEL_SORT_RUN;
+    if (start + k0 >= stop) return;
+    size_t k1 = k0 + DAWN__PARALLEL_SORT_RUN < stop - start ? k0 + DAWN__PARALLEL_SORT_RUN : stop - start;
+
+    const unsigned char *a = ps->src + start*f->item_size;
+    const unsigned char *b = ps->src + mid*f->item_size;
+    size_t count_a = mid - start;
+    size_t count_b = stop - mid;
+    size_t i0 = dawn__merge_split(f, a, count_a, b, count_b, k0);
+    size_t i1 = dawn__merge_split(f, a, count_a, b, count_b, k1);
+    f->merge(a + i0*f->item_size, i1 - i0, b + (k0 - i0)*f->item_size, (k1 - i1) - (k0 - i0),
+             ps->dst + (start + k0)*f->item_size);
+}
+
+static void dawn__parallel_sort_copy(void *ctx, size_t task) {
+    Dawn__ParallelSort *ps = (Dawn__ParallelSort *)ctx;
+    size_t begin = task*DAWN__PARALLEL_SORT_RUN;
+    size_t end = begin + DAWN__PARALLEL_SORT_RUN < ps->count ? begin + DAWN__PARALLEL_SORT_RUN : ps->count;
+    size_t size = ps->functions->item_size;
+    memcpy(ps->dst + begin*size, ps->src + begin*size, (end - begin)*size);
+}
+
+void dawn_parallel_sort(void *items, size_t count, const DawnSortFunctions *functions, size_t thread_count) {
+    if (count <= DAWN__PARALLEL_SORT_RUN) {
+        functions->sort(items, count);
+        return;
+    }
+    unsigned char *scratch = (unsigned char *)malloc(count*functions->item_size);
+    assert(scratch && "Not enough RAM for malloc");
+    Dawn__ParallelSort ps = {functions, (unsigned char *)items, scratch, count, DAWN__PARALLEL_SORT_RUN};
+    size_t runs = (count + DAWN__PARALLEL_SORT_RUN - 1)/DAWN__PARALLEL_SORT_RUN;
+
+#ifdef DAWN__HAS_PTHREAD
+    if (thread_count == 0) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        thread_count = online > 0 ? (size_t)online : 1;
+    }
+    if (thread_count > runs) thread_count = runs;
+    Dawn__Pool pool = {0};
+    pthread_mutex_init(&pool.lock, NULL);
+    pthread_cond_init(&pool.work_ready, NULL);
+    pthread_cond_init(&pool.work_done, NULL);
+    pool.thread_count = thread_count;
+    pool.queues = (Dawn__TaskQueue *)calloc(thread_count, sizeof *pool.queues);
+    assert(pool.queues && "Not enough RAM for calloc");
+    for (size_t i = 0; i < thread_count; ++i) pthread_mutex_init(&pool.queues[i].lock, NULL);
+    pthread_t *threads = (pthread_t *)malloc(thread_count*sizeof *threads);
+    Dawn__PoolWorker *workers = (Dawn__PoolWorker *)malloc(thread_count*sizeof *workers);
+    assert(threads && workers && "Not enough RAM for malloc");
+    size_t started = 1;
+    for (; started < thread_count; ++started) {
+        workers[started].pool = &pool;
+        workers[started].index = started;
+        if (pthread_create(&threads[started], NULL, dawn__pool_thread, &workers[started]) != 0) break;
+    }
+    // Fewer threads only mean fewer workers, the queues of the missing ones get stolen.
+#define DAWN__POOL_RUN(run, task_count) dawn__pool_run(&pool, (run), &ps, (task_count))
+#else
+    (void)thread_count;
+#define DAWN__POOL_RUN(run, task_count)                                        \
+    do {                                                                       \
+        for (size_t dawn_task = 0; dawn_task < (task_count); ++dawn_task) {    \
+            (run)(&ps, dawn_task);                                             \
+        }                                                                      \
+    } while (0)
+#endif
+
+    DAWN__POOL_RUN(dawn__parallel_sort_run, runs);
+    for (; ps.width < count; ps.width *= 2) {
+        size_t pairs = (count + 2*ps.width - 1)/(2*ps.width);
+        DAWN__POOL_RUN(dawn__parallel_sort_merge, pairs*(2*ps.width/DAWN__PARALLEL_SORT_RUN));
+        unsigned char *temp = ps.src;
+        ps.src = ps.dst;
+        ps.dst = temp;
+    }
+    if (ps.src != items) {
+        ps.dst = (unsigned char *)items;
+        DAWN__POOL_RUN(dawn__parallel_sort_copy, runs);
+    }
+#undef DAWN__POOL_RUN
+
+#ifdef DAWN__HAS_PTHREAD
+    pthread_mutex_lock(&pool.lock);
+    pool.stop = true;
+    pthread_cond_broadcast(&pool.work_ready);
+    pthread_mutex_unlock(&pool.lock);
+    for (size_t i = 1; i < started; ++i) pthread_join(threads[i], NULL);
+    for (size_t i = 0; i < thread_count; ++i) pthread_mutex_destroy(&pool.queues[i].lock);
+    pthread_cond_destroy(&pool.work_done);
+    pthread_cond_destroy(&pool.work_ready);
+    pthread_mutex_destroy(&pool.lock);
+    free(workers);
+    free(threads);
+    free(pool.queues);
+#endif
+    free(scratch);
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+#define DAWN__PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define DAWN__PREFETCH(addr) ((void)0)
+#endif
+
+#define DAWN__DEFINE_LOWER_BOUND(name, type)                                                \
+    size_t name(const type *items, size_t count, type key) {                                \
+        if (count == 0) return 0;                                                           \
+        const type *base = items;                                                           \
+        for (size_t n = count; n > 1;) {                                                    \
+            size_t half = n/2;                                                              \
+            /* Without a branch nothing is loaded speculatively, so fetch both */           \
+            /* possible next probes for arrays larger than the cache. There are */          \
+            /* none in the last step, where base - 1 would be out of bounds. */             \
+            if (n - half > 1) {                                                             \
+                DAWN__PREFETCH(base + (n - half)/2 - 1);                                    \
+                DAWN__PREFETCH(base + half + (n - half)/2 - 1);                             \
+            }                                                                               \
+            /* A mask rather than ?: keeps compilers from turning it back into a branch. */ \
+            base += half & (0 - (size_t)(base[half - 1] < key));                            \
+            n -= half;                                                                      \
+        }                                                                                   \
+        return (size_t)(base - items) + (*base < key);                                      \
+    }
+
+DAWN__DEFINE_LOWER_BOUND(dawn_lower_bound_u32, uint32_t)
+DAWN__DEFINE_LOWER_BOUND(dawn_lower_bound_u64, uint64_t)
+
+// One block holds ranks[slots] followed by keys[slots] aligned to a cache line.
+static void *dawn__search_index_alloc(size_t slots, size_t key_size, size_t **ranks) {
+    *ranks = (size_t *)malloc(slots*sizeof(size_t) + 64 + slots*key_size);
+    assert(*ranks && "Not enough RAM for malloc");
+    uintptr_t keys = (uintptr_t)(*ranks + slots);
+    return (void *)((keys + 63) & ~(uintptr_t)63);
+}
+
+// Number the nodes of the implicit tree k in order, giving their index in the sorted array.
+static size_t dawn__eytzinger_fill(size_t *ranks, size_t length, size_t k, size_t next) {
+    if (k <= length) {
+        next = dawn__eytzinger_fill(ranks, length, 2*k, next);
+        ranks[k] = next++;
+        next = dawn__eytzinger_fill(ranks, length, 2*k + 1, next);
+    }
+    return next;
+}
+
+void dawn_eytzinger32_build(DawnEytzinger32 *index, const uint32_t *sorted, size_t count) {
+    index->length = count;
+    index->keys = (uint32_t *)dawn__search_index_alloc(count + 1, sizeof *index->keys, &index->ranks);
+    dawn__eytzinger_fill(index->ranks, count, 1, 0);
+    index->keys[0] = 0;
+    index->ranks[0] = count;
+    for (size_t k = 1; k <= count; ++k) index->keys[k] = sorted[index->ranks[k]];
+}
+
+void dawn_eytzinger64_build(DawnEytzinger64 *index, const uint64_t *sorted, size_t count) {
+    index->length = count;
+    index->keys = (uint64_t *)dawn__search_index_alloc(count + 1, sizeof *index->keys, &index->ranks);
+    dawn__eytzinger_fill(index->ranks, count, 1, 0);
+    index->keys[0] = 0;
+    index->ranks[0] = count;
+    for (size_t k = 1; k <= count; ++k) index->keys[k] = sorted[index->ranks[k]];
+}
+
+// The descent goes right at every key below the search key and left
+// otherwise. The answer is the node of the last left turn, found by
+// dropping the trailing right turns and that turn from k. No left turn
+// leaves k = 0, whose rank is length.
+size_t dawn_eytzinger32_lower_bound(const DawnEytzinger32 *index, uint32_t key) {
+    size_t k = 1;
+    while (k <= index->length) {
+        // The 16 descendants four levels down share one cache line. Near the
+        // leaves it lies past the keys, so the address is computed as an integer.
+        DAWN__PREFETCH((const void *)((uintptr_t)index->keys + 64*k));
+        k = 2*k + (index->keys[k] < key);
+    }
+    k >>= dawn__ctz64(~(uint64_t)k) + 1;
+    return index->ranks[k];
+}
+
+size_t dawn_eytzinger64_lower_bound(const DawnEytzinger64 *index, uint64_t key) {
+    size_t k = 1;
+    while (k <= index->length) {
+        // The 8 descendants three levels down share one cache line. Near the
+        // leaves it lies past the keys, so the address is computed as an integer.
+        DAWN__PREFETCH((const void *)((uintptr_t)index->keys + 64*k));
+        k = 2*k + (index->keys[k] < key);
+    }
+    k >>= dawn__ctz64(~(uint64_t)k) + 1;
+    return index->ranks[k];
+}
+
+#define DAWN__BTREE_B 16
+
+static void dawn__btree_fill(size_t *ranks, size_t node_count, size_t k, size_t *next) {
+    if (k >= node_count) return;
+    for (size_t i = 0; i < DAWN__BTREE_B; ++i) {
+        dawn__btree_fill(ranks, node_count, k*(DAWN__BTREE_B + 1) + i + 1, next);
+        ranks[k*DAWN__BTREE_B + i] = (*next)++;
+    }
+    dawn__btree_fill(ranks, node_count, k*(DAWN__BTREE_B + 1) + DAWN__BTREE_B + 1, next);
+}
+
+void dawn_btree32_build(DawnBTree32 *tree, const uint32_t *sorted, size_t count) {
+    tree->length = count;
+    tree->node_count = (count + DAWN__BTREE_B - 1)/DAWN__BTREE_B;
+    size_t slots = tree->node_count*DAWN__BTREE_B;
+    tree->keys = (uint32_t *)dawn__search_index_alloc(slots, sizeof *tree->keys, &tree->ranks);
+    size_t next = 0;
+    dawn__btree_fill(tree->ranks, tree->node_count, 0, &next);
+    for (size_t slot = 0; slot < slots; ++slot) {
+        // The padding of the last node sorts after every key and maps to "not found".
+        if (tree->ranks[slot] < count) {
+            tree->keys[slot] = sorted[tree->ranks[slot]] ^ 0x80000000u;
+        } else {
+            tree->keys[slot] = 0x7FFFFFFF;
+            tree->ranks[slot] = count;
+        }
+    }
+}
+
+// Number of keys of the node that are less than key, both with flipped sign bits.
+static inline unsigned dawn__btree_rank(const uint32_t *node, uint32_t key) {
+#if defined(DAWN_HAS_AVX2)
+    __m256i x = _mm256_set1_epi32((int)key);
+    __m256i lo = _mm256_cmpgt_epi32(x, _mm256_load_si256((const __m256i *)node));
+    __m256i hi = _mm256_cmpgt_epi32(x, _mm256_load_si256((const __m256i *)(node + 8)));
+    uint32_t mask = (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(lo)) |
+                    (uint32_t)_mm256_movemask_ps(_mm256_castsi256_ps(hi)) << 8;
+    // The keys are sorted, so the mask is a run of ones.
+    return dawn__ctz32(~mask);
+#elif defined(DAWN_HAS_SSE2)
+    __m128i x = _mm_set1_epi32((int)key);
+    __m128i c0 = _mm_cmpgt_epi32(x, _mm_load_si128((const __m128i *)node));
+    __m128i c1 = _mm_cmpgt_epi32(x, _mm_load_si128((const __m128i *)(node + 4)));
+    __m128i c2 = _mm_cmpgt_epi32(x, _mm_load_si128((const __m128i *)(node + 8)));
+    __m128i c3 = _mm_cmpgt_epi32(x, _mm_load_si128((const __m128i *)(node + 12)));
+    __m128i bytes = _mm_packs_epi16(_mm_packs_epi32(c0, c1), _mm_packs_epi32(c2, c3));
+    return dawn__ctz32(~(uint32_t)_mm_movemask_epi8(bytes));
+#else
+    unsigned rank = 0;
+    for (unsigned i = 0; i < DAWN__BTREE_B; ++i) rank += (int32_t)node[i] < (int32_t)key;
+    return rank;
+#endif
+}
+
+size_t dawn_btree32_lower_bound(const DawnBTree32 *tree, uint32_t key) {
+    uint32_t flipped = key ^ 0x80000000u;
+    size_t result = tree->length;
+    size_t k = 0;
+    while (k < tree->node_count) {
+        unsigned i = dawn__btree_rank(tree->keys + k*DAWN__BTREE_B, flipped);
+        // Keys found further down are smaller, so they replace this candidate.
+        if (i < DAWN__BTREE_B) result = tree->ranks[k*DAWN__BTREE_B + i];
+        k = k*(DAWN__BTREE_B + 1) + i + 1;
     }
     return result;
 }
@@ -0,0 +1,134 @@
+// Round-trips base64 (both alphabets) and hex against a byte-at-a-time
+// reference. The Makefile builds it once per SIMD level so the AVX2, SSSE3
+// and scalar kernels are all exercised.
+// Usage: ./test_encoding [iterations]
+
+#define DAWN_IMPLEMENTATION
+#include "../dawn_utils.h"
+
+static size_t failures = 0;
+
+#define CHECK(cond, ...)                                   \
+    do {                                                   \
+        if (!(cond) && failures++ < 20) printf(__VA_ARGS__); \
+    } while (0)
+
+static size_t reference_base64(char *out, const unsigned char *data, size_t length, DawnBase64Alphabet alphabet) {
+    const char *digits = alphabet == DAWN_BASE64_URL
+        ? "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_"
+        : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    size_t n = 0;
+    for (size_t i = 0; i < length; i += 3) {
+        size_t left = length - i < 3 ? length - i : 3;
+        uint32_t v = (uint32_t)data[i] << 16;
+        if (left > 1) v |= (uint32_t)data[i + 1] << 8;
+        if (left > 2) v |= data[i + 2];
+        for (size_t j = 0; j <= left; ++j) out[n++] = digits[v >> (18 - 6*j) & 63];
+        if (alphabet == DAWN_BASE64_STANDARD) {
+            for (size_t j = left; j < 3; ++j) out[n++] = '=';
+        }
+    }
+    return n;
+}
+
+static void check_base64(const unsigned char *data, size_t length, DawnBase64Alphabet alphabet, char *expected) {
+    size_t expected_length = reference_base64(expected, data, length, alphabet);
+    DawnStringBuilder sb = {0};
+    dawn_sb_append_base64(&sb, data, length, alphabet);
+    CHECK(sb.length == expected_length && memcmp(sb.items, expected, expected_length) == 0,
+          "base64 encode of %zu bytes (alphabet %d) differs\n", length, (int)alphabet);
+
+    // Decode after a prefix byte so that appending is checked too.
+    DawnStringBuilder out = {0};
+    DAWN_DA_APPEND(&out, '#');
+    bool ok = dawn_sb_append_base64_decoded(&out, expected, expected_length, alphabet);
+    CHECK(ok && out.length == length + 1 && memcmp(out.items + 1, data, length) == 0,
+          "base64 decode of %zu bytes (alphabet %d) failed\n", length, (int)alphabet);
+
+    // The decoder accepts unpadded text in either alphabet.
+    size_t unpadded = expected_length;
+    while (unpadded > 0 && expected[unpadded - 1] == '=') unpadded--;
+    out.length = 0;
+    ok = dawn_sb_append_base64_decoded(&out, expected, unpadded, alphabet);
+    CHECK(ok && out.length == length && memcmp(out.items, data, length) == 0,
+          "unpadded base64 decode of %zu bytes (alphabet %d) failed\n", length, (int)alphabet);
+
+    // A character from outside the alphabet anywhere must be rejected
+    // without changing the builder.
+    if (unpadded > 0) {
+        size_t position = (length * 7919) % unpadded;
+        char saved = expected[position];
+        expected[position] = alphabet == DAWN_BASE64_URL ? '+' : '-';
+        out.length = 0;
+        ok = dawn_sb_append_base64_decoded(&out, expected, unpadded, alphabet);
+        CHECK(!ok && out.length == 0, "invalid byte at %zu of %zu accepted\n", position, unpadded);
+        expected[position] = saved;
+    }
+    DAWN_SB_FREE(sb);
+    DAWN_SB_FREE(out);
+}
+
+static void check_hex(const unsigned char *data, size_t length, char *expected) {
+    for (size_t i = 0; i < length; ++i) snprintf(expected + 2*i, 3, "%02x", data[i]);
+    DawnStringBuilder sb = {0};
+    dawn_sb_append_hex_bytes(&sb, data, length);
+    CHECK(sb.length == 2*length && memcmp(sb.items, expected, 2*length) == 0, "hex encode of %zu bytes differs\n", length);
+
+    for (size_t i = 0; i < 2*length; i += 3) {
+        if (expected[i] >= 'a') expected[i] = (char)(expected[i] - 'a' + 'A');
+    }
+    DawnStringBuilder out = {0};
+    bool ok = dawn_sb_append_hex_decoded(&out, expected, 2*length);
+    CHECK(ok && out.length == length && memcmp(out.items, data, length) == 0, "hex decode of %zu bytes failed\n", length);
+    DAWN_SB_FREE(sb);
+    DAWN_SB_FREE(out);
+}
+
+static void check_rejected(const char *text, DawnBase64Alphabet alphabet) {
+    DawnStringBuilder out = {0};
+    bool ok = dawn_sb_append_base64_decoded(&out, text, strlen(text), alphabet);
+    CHECK(!ok && out.length == 0, "base64 '%s' accepted\n", text);
+    DAWN_SB_FREE(out);
+}
+
+int main(int argc, char **argv) {
+    size_t iterations = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 20000;
+
+    DawnRng rng;
+    dawn_rng_seed(&rng, DAWN_RNG_XOSHIRO256PP, 36);
+    enum { MAX_LENGTH = 1024 };
+    static unsigned char data[MAX_LENGTH];
+    static char text[2*MAX_LENGTH + 4];
+
+    // Every length up to a few AVX2 blocks covers all lengths mod 3 and
+    // every split between the vector loops and the scalar tail.
+    for (size_t length = 0; length <= 200; ++length) {
+        for (size_t i = 0; i < length; ++i) data[i] = (unsigned char)dawn_rng_u64(&rng);
+        check_base64(data, length, DAWN_BASE64_STANDARD, text);
+        check_base64(data, length, DAWN_BASE64_URL, text);
+        check_hex(data, length, text);
+    }
+    for (size_t it = 0; it < iterations; ++it) {
+        size_t length = dawn_rng_bounded(&rng, MAX_LENGTH + 1);
+        for (size_t i = 0; i < length; ++i) data[i] = (unsigned char)dawn_rng_u64(&rng);
+        check_base64(data, length, (DawnBase64Alphabet)dawn_rng_bounded(&rng, 2), text);
+        check_hex(data, length, text);
+    }
+
+    // Non-canonical trailing bits, bad padding and impossible lengths.
+    static const char *rejected[] = {"QR==", "QR", "QUJ=", "QUJ", "Q", "Q===", "QQ=", "====", "Zm9v\n"};
+    for (size_t i = 0; i < sizeof rejected/sizeof *rejected; ++i) check_rejected(rejected[i], DAWN_BASE64_STANDARD);
+    check_rejected("QUJ", DAWN_BASE64_URL);
+    check_rejected("Zm9v+A", DAWN_BASE64_URL);
+    DawnStringBuilder out = {0};
+    CHECK(dawn_sb_append_base64_decoded(&out, "QQ==", 4, DAWN_BASE64_STANDARD) && out.length == 1 && out.items[0] == 'A',
+          "base64 'QQ==' rejected\n");
+    DAWN_SB_FREE(out);
+
+    if (failures > 0) {
+        printf("test_encoding: %zu failures\n", failures);
+        return 1;
+    }
+    printf("test_encoding: %zu random cases ok\n", iterations);
+    return 0;
+}
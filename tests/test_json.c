@@ -0,0 +1,76 @@
+// Checks the token sequences dawn_json_next produces for small documents,
+// in particular that numbers and literals must end at a delimiter.
+// Usage: ./test_json
+
+#define DAWN_IMPLEMENTATION
+#include "../dawn_utils.h"
+
+static size_t failures = 0;
+
+// One character per token: the punctuation itself, s for a string, n for a
+// number, t/f/u for true/false/null, E for an error and . for the end.
+static char token_char(DawnJsonTokenKind kind) {
+    switch (kind) {
+    case DAWN_JSON_END: return '.';
+    case DAWN_JSON_ERROR: return 'E';
+    case DAWN_JSON_OBJECT_BEGIN: return '{';
+    case DAWN_JSON_OBJECT_END: return '}';
+    case DAWN_JSON_ARRAY_BEGIN: return '[';
+    case DAWN_JSON_ARRAY_END: return ']';
+    case DAWN_JSON_COLON: return ':';
+    case DAWN_JSON_COMMA: return ',';
+    case DAWN_JSON_STRING: return 's';
+    case DAWN_JSON_NUMBER: return 'n';
+    case DAWN_JSON_TRUE: return 't';
+    case DAWN_JSON_FALSE: return 'f';
+    case DAWN_JSON_NULL: return 'u';
+    }
+    return '?';
+}
+
+static void check(const char *json, const char *expected) {
+    DawnJsonTokenizer tk = DAWN_JSON_TOKENIZER_INIT(json, strlen(json));
+    char got[64];
+    size_t n = 0;
+    for (;;) {
+        DawnJsonToken token = dawn_json_next(&tk);
+        got[n++] = token_char(token.kind);
+        if (token.kind == DAWN_JSON_END || token.kind == DAWN_JSON_ERROR || n + 1 == sizeof got) break;
+    }
+    got[n] = '\0';
+    if (strcmp(got, expected) != 0 && failures++ < 20) {
+        printf("'%s': expected %s, got %s\n", json, expected, got);
+    }
+}
+
+int main(void) {
+    check("", ".");
+    check("{\"a\": [1, -2.5e3, true, false, null]}", "{s:[n,n,t,f,u]}.");
+    check("[0,-0,0.5,1e9]", "[n,n,n,n].");
+    check("0 1", "nn.");
+    check("null\n", "u.");
+    check("{\"a\":1}", "{s:n}.");
+
+    check("01", "E");
+    check("-01.5", "E");
+    check("[01]", "[E");
+    check("1.", "E");
+    check("1e", "E");
+    check("-", "E");
+    check("+1", "E");
+    check("1x", "E");
+    check("1\"a\"", "E");
+    check("nullnull", "E");
+    check("truefalse", "E");
+    check("true1", "E");
+    check("falsey", "E");
+    check("nul", "E");
+    check("[null{]", "[E");
+
+    if (failures > 0) {
+        printf("test_json: %zu failures\n", failures);
+        return 1;
+    }
+    printf("test_json: ok\n");
+    return 0;
+}
@@ -0,0 +1,131 @@
+// Fuzzes dawn_parse_u64/i64/f64 against strtoull/strtoll/strtod.
+// Usage: ./test_parse [iterations]
+
+#define DAWN_IMPLEMENTATION
+#include "../dawn_utils.h"
+
+#include <errno.h>
+
+static size_t failures = 0;
+
+static void check_f64(const char *text) {
+    char *end;
+    double expected = strtod(text, &end);
+    double value = 0;
+    size_t consumed = dawn_parse_f64(text, strlen(text), &value);
+    bool same = isnan(expected) ? isnan(value) : memcmp(&expected, &value, sizeof value) == 0;
+    if (consumed != (size_t)(end - text) || (consumed > 0 && !same)) {
+        if (failures++ < 20) {
+            printf("f64 '%s': strtod %a (%zu bytes), dawn %a (%zu bytes)\n",
+                   text, expected, (size_t)(end - text), value, consumed);
+        }
+    }
+}
+
+static void check_int(const char *text) {
+    char *end;
+    errno = 0;
+    long long expected = strtoll(text, &end, 10);
+    bool overflow = errno == ERANGE;
+    int64_t value = 0;
+    size_t consumed = dawn_parse_i64(text, strlen(text), &value);
+    if (overflow ? consumed != 0 : consumed != (size_t)(end - text) || (consumed > 0 && value != expected)) {
+        if (failures++ < 20) printf("i64 '%s': strtoll %lld, dawn %lld (%zu bytes)\n", text, expected, (long long)value, consumed);
+    }
+
+    uint64_t value_u = 0;
+    if (text[0] == '-') {
+        // Unlike strtoull, dawn_parse_u64 rejects every negative input.
+        if (dawn_parse_u64(text, strlen(text), &value_u) != 0 && failures++ < 20) printf("u64 '%s' accepted\n", text);
+        return;
+    }
+    errno = 0;
+    unsigned long long expected_u = strtoull(text, &end, 10);
+    overflow = errno == ERANGE;
+    consumed = dawn_parse_u64(text, strlen(text), &value_u);
+    if (overflow ? consumed != 0 : consumed != (size_t)(end - text) || (consumed > 0 && value_u != expected_u)) {
+        if (failures++ < 20) printf("u64 '%s': strtoull %llu, dawn %llu (%zu bytes)\n", text, expected_u, (unsigned long long)value_u, consumed);
+    }
+}
+
+// Digits with an optional point and a random exponent, to reach the slow
+// paths with many digits and values near the subnormal and overflow limits.
+static void random_digits(DawnRng *rng, char *buf, size_t size) {
+    size_t digits = 1 + dawn_rng_bounded(rng, 30);
+    size_t point = dawn_rng_bounded(rng, digits + 1);
+    size_t n = 0;
+    if (dawn_rng_bounded(rng, 4) == 0) buf[n++] = '-';
+    for (size_t i = 0; i < digits; ++i) {
+        if (i == point && dawn_rng_bounded(rng, 2)) buf[n++] = '.';
+        buf[n++] = (char)('0' + dawn_rng_bounded(rng, 10));
+    }
+    snprintf(buf + n, size - n, "e%d", (int)dawn_rng_bounded(rng, 700) - 350);
+}
+
+int main(int argc, char **argv) {
+    size_t iterations = argc > 1 ? (size_t)strtoull(argv[1], NULL, 10) : 1000000;
+
+    static const char *fixed[] = {
+        "0", "-0", "1", "1.", "1.5", "-1.5e3", ".5", "5.", "1e", "1e+", "1e5x", "-", "+.e1", "",
+        "inf", "-Infinity", "nan", "infinit",
+        "2.2250738585072011e-308", "4.9e-324", "2.4703282292062327e-324", "2.4703282292062328e-324",
+        "1.7976931348623158e308", "1.7976931348623159e308", "1e-400", "1e400",
+        "9007199254740993", "9007199254740993.0000000000000000001", "0.1", "1e23", "8.589973e9",
+        "7.2057594037927933e16", "3.14159265358979323846264338327950288",
+        "123456789012345678901234567890e-10", "0.000000000000000000000000000000000001e35",
+        "000000000000000000000000000000000000000000001.5",
+        "1.00000000000000011102230246251565404236316680908203124",
+        "1.00000000000000011102230246251565404236316680908203125",
+        "1.00000000000000011102230246251565404236316680908203126",
+    };
+    for (size_t i = 0; i < sizeof fixed/sizeof *fixed; ++i) check_f64(fixed[i]);
+
+    static const char *fixed_int[] = {
+        "0", "-0", "42", "007", "-", "+1", "18446744073709551615", "18446744073709551616",
+        "9223372036854775807", "9223372036854775808", "-9223372036854775808", "-9223372036854775809",
+        "99999999999999999999999",
+    };
+    for (size_t i = 0; i < sizeof fixed_int/sizeof *fixed_int; ++i) check_int(fixed_int[i]);
+
+    DawnRng rng;
+    dawn_rng_seed(&rng, DAWN_RNG_XOSHIRO256PP, 32);
+    char buf[128];
+    DawnStringBuilder sb = {0};
+    for (size_t i = 0; i < iterations; ++i) {
+        uint64_t bits = dawn_rng_u64(&rng);
+        double d;
+        memcpy(&d, &bits, sizeof d);
+        switch (dawn_rng_bounded(&rng, 4)) {
+        case 0:
+            snprintf(buf, sizeof buf, "%.17g", d);
+            break;
+        case 1:
+            snprintf(buf, sizeof buf, "%.*e", (int)dawn_rng_bounded(&rng, 25), d);
+            break;
+        case 2:
+            random_digits(&rng, buf, sizeof buf);
+            break;
+        default:
+            sb.length = 0;
+            dawn_sb_append_f64(&sb, d);
+            snprintf(buf, sizeof buf, "%.*s", (int)sb.length, sb.items);
+            break;
+        }
+        check_f64(buf);
+
+        size_t digits = 1 + dawn_rng_bounded(&rng, 22);
+        size_t n = 0;
+        if (dawn_rng_bounded(&rng, 3) == 0) buf[n++] = '-';
+        for (size_t j = 0; j < digits; ++j) buf[n++] = (char)('0' + dawn_rng_bounded(&rng, 10));
+        buf[n] = '\0';
+        check_int(buf);
+    }
+    DAWN_SB_FREE(sb);
+
+    if (failures > 0) {
+        printf("test_parse: %zu failures\n", failures);
+        return 1;
+    }
+    printf("test_parse: %zu random cases ok\n", iterations);
+    return 0;
+}